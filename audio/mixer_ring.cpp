@@ -0,0 +1,138 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/mixer_ring.h"
+#include "audio/mixer_intern.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Audio {
+
+/**
+ * Keep the block contents and the counter publishing them from being
+ * reordered against each other.
+ */
+static inline void memoryBarrier() {
+#if defined(__GNUC__) && defined(__mc68000__)
+	// The Amiga has a single in-order CPU, only the compiler can reorder.
+	__asm__ __volatile__("" : : : "memory");
+#elif defined(__GNUC__)
+	__sync_synchronize();
+#elif defined(_MSC_VER)
+	_ReadWriteBarrier();
+#endif
+}
+
+MixerRingBuffer::MixerRingBuffer(MixerImpl *mixer, uint blockSamples, uint numBlocks)
+	: _mixer(mixer), _blockSamples(blockSamples), _numBlocks(numBlocks),
+	  _writeIndex(0), _readIndex(0), _readOffset(0), _underruns(0), _underrunSamples(0) {
+	assert(blockSamples > 0);
+	assert(numBlocks >= 2);
+
+	_buffer = new int16[_blockSamples * _numBlocks * 2];
+	_blockMixed = new int[_numBlocks];
+}
+
+MixerRingBuffer::~MixerRingBuffer() {
+	delete[] _buffer;
+	delete[] _blockMixed;
+}
+
+uint MixerRingBuffer::blocksForLatency(uint latencyMs, uint sampleRate, uint blockSamples) {
+	const uint samples = (uint)((uint64)latencyMs * sampleRate / 1000);
+	const uint blocks = (samples + blockSamples - 1) / blockSamples;
+	return MAX<uint>(blocks, 2);
+}
+
+uint MixerRingBuffer::produce(uint maxBlocks) {
+	uint mixed = 0;
+
+	while (_writeIndex - _readIndex < _numBlocks) {
+		if (maxBlocks && mixed == maxBlocks)
+			break;
+
+		const uint slot = _writeIndex % _numBlocks;
+		_blockMixed[slot] = mixBlock(_buffer + slot * _blockSamples * 2, _blockSamples);
+
+		memoryBarrier();
+		_writeIndex = _writeIndex + 1;
+		++mixed;
+	}
+
+	return mixed;
+}
+
+int MixerRingBuffer::consume(byte *samples, uint len) {
+	assert(samples);
+	assert(len % 4 == 0);
+
+	int16 *dst = (int16 *)samples;
+	uint left = len >> 2;
+	int audible = 0;
+
+	while (left) {
+		if (_writeIndex == _readIndex) {
+			memset(dst, 0, left * 4);
+			_underruns = _underruns + 1;
+			_underrunSamples = _underrunSamples + left;
+			break;
+		}
+		memoryBarrier();
+
+		const uint slot = _readIndex % _numBlocks;
+		const uint count = MIN(left, _blockSamples - _readOffset);
+		memcpy(dst, _buffer + (slot * _blockSamples + _readOffset) * 2, count * 4);
+
+		const int mixed = _blockMixed[slot] - (int)_readOffset;
+		if (mixed > 0)
+			audible += MIN<int>(mixed, count);
+
+		dst += count * 2;
+		left -= count;
+		_readOffset += count;
+
+		if (_readOffset == _blockSamples) {
+			_readOffset = 0;
+			memoryBarrier();
+			_readIndex = _readIndex + 1;
+		}
+	}
+
+	return audible;
+}
+
+void MixerRingBuffer::reset() {
+	_writeIndex = 0;
+	_readIndex = 0;
+	_readOffset = 0;
+	_underruns = 0;
+	_underrunSamples = 0;
+}
+
+int MixerRingBuffer::mixBlock(int16 *buf, uint samples) {
+	assert(_mixer);
+	return _mixer->mixCallback((byte *)buf, samples * 4);
+}
+
+} // End of namespace Audio
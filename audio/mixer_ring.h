@@ -0,0 +1,135 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_MIXER_RING_H
+#define AUDIO_MIXER_RING_H
+
+#include "common/scummsys.h"
+
+namespace Audio {
+
+class MixerImpl;
+
+/**
+ * A ring of fixed-size blocks of mixed stereo 16-bit samples, placed between
+ * a MixerImpl and the audio device.
+ *
+ * Without it the device callback calls MixerImpl::mixCallback() directly,
+ * which holds the mixer mutex for as long as all channels take to mix, so
+ * engine calls like playStream() or stopHandle() and the audio device wait
+ * on each other. With it a separate producer thread calls produce() to mix
+ * ahead into free blocks, and the device callback calls consume(), which
+ * only copies finished blocks out and never takes the mutex.
+ *
+ * There must be exactly one producer and one consumer thread. They share
+ * nothing but the read and write block counters, so no lock is needed.
+ * When the producer falls behind, consume() pads with silence and counts
+ * an underrun.
+ */
+class MixerRingBuffer {
+public:
+	/**
+	 * @param mixer        the mixer blocks are mixed from (may be NULL for subclasses overriding mixBlock())
+	 * @param blockSamples number of sample pairs in one block
+	 * @param numBlocks    number of blocks in the ring, at least 2
+	 */
+	MixerRingBuffer(MixerImpl *mixer, uint blockSamples, uint numBlocks);
+	virtual ~MixerRingBuffer();
+
+	/**
+	 * Return the number of blocks needed to hold the given latency, at least 2.
+	 */
+	static uint blocksForLatency(uint latencyMs, uint sampleRate, uint blockSamples);
+
+	/**
+	 * Producer side: mix into free blocks until the ring is full.
+	 *
+	 * @param maxBlocks stop after this many blocks, 0 for no limit
+	 * @return number of blocks mixed
+	 */
+	uint produce(uint maxBlocks = 0);
+
+	/**
+	 * Consumer side: copy mixed samples out of the ring. Whatever the ring
+	 * cannot provide is filled with silence and counted as an underrun.
+	 *
+	 * @param samples buffer for stereo 16-bit samples
+	 * @param len     length of the buffer in bytes, divisible by 4
+	 * @return number of sample pairs taken from blocks the mixer reported
+	 *         as holding sound, in the same sense as MixerImpl::mixCallback()
+	 */
+	int consume(byte *samples, uint len);
+
+	/**
+	 * Drop all mixed blocks and statistics. Neither side may be running.
+	 */
+	void reset();
+
+	uint getBlockSamples() const { return _blockSamples; }
+	uint getNumBlocks() const { return _numBlocks; }
+
+	/** Return the number of mixed blocks waiting to be consumed. */
+	uint getFilledBlocks() const { return _writeIndex - _readIndex; }
+
+	/** Return the maximum number of sample pairs mixed ahead of the device. */
+	uint getLatencySamples() const { return _blockSamples * _numBlocks; }
+
+	/** Return the number of consume() calls that had to pad with silence. */
+	uint32 getUnderruns() const { return _underruns; }
+
+	/** Return the number of sample pairs of silence padded in by consume(). */
+	uint32 getUnderrunSamples() const { return _underrunSamples; }
+
+	/** Return the number of blocks mixed since the last reset(). */
+	uint32 getBlocksMixed() const { return _writeIndex; }
+
+protected:
+	/**
+	 * Fill one block with mixed samples.
+	 *
+	 * @return number of sample pairs holding sound, see MixerImpl::mixCallback()
+	 */
+	virtual int mixBlock(int16 *buf, uint samples);
+
+private:
+	MixerImpl *_mixer;
+
+	const uint _blockSamples;
+	const uint _numBlocks;
+
+	int16 *_buffer;
+	int *_blockMixed;
+
+	// Both counters only ever grow; the block slot is counter % _numBlocks.
+	// _writeIndex is only written by the producer, _readIndex and
+	// _readOffset only by the consumer.
+	volatile uint32 _writeIndex;
+	volatile uint32 _readIndex;
+	uint _readOffset;
+
+	volatile uint32 _underruns;
+	volatile uint32 _underrunSamples;
+};
+
+} // End of namespace Audio
+
+#endif
@@ -13,6 +13,7 @@ MODULE_OBJS := \
 	miles_adlib.o \
 	miles_midi.o \
 	mixer.o \
+	mixer_ring.o \
 	mpu401.o \
 	musicplugin.o \
 	null.o \
@@ -277,6 +277,148 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 #pragma mark -
 
 
+/**
+ * Mixer volumes go up to Audio::Mixer::kMaxMixerVolume, which is 1 << this.
+ * The block based converters below scale with a shift instead of a division.
+ */
+#define VOLUME_SHIFT 8
+
+/**
+ * Mix one frame into the output buffer. With unity gain (both volumes at
+ * Audio::Mixer::kMaxMixerVolume) the samples are added unscaled.
+ */
+template<bool reverseStereo, bool unity>
+static inline void mixFrame(st_sample_t *obuf, int out0, int out1, int vol_l, int vol_r) {
+	if (unity) {
+		clampedAdd(obuf[reverseStereo    ], out0);
+		clampedAdd(obuf[reverseStereo ^ 1], out1);
+	} else {
+		clampedAdd(obuf[reverseStereo    ], (out0 * vol_l) >> VOLUME_SHIFT);
+		clampedAdd(obuf[reverseStereo ^ 1], (out1 * vol_r) >> VOLUME_SHIFT);
+	}
+}
+
+/**
+ * Audio rate converter for upsampling by exactly 2 or 4 (1 << shift), the
+ * common case of 11025 or 22050 Hz game audio on a 22050 or 44100 Hz mixer.
+ *
+ * It produces the same linear interpolation as LinearRateConverter, but
+ * works on whole input cache blocks: every input frame expands into a fixed
+ * number of output frames with no fractional position to track, and unity
+ * gain skips the volume scaling altogether.
+ */
+template<bool stereo, bool reverseStereo, int shift>
+class UpsamplingRateConverter : public RateConverter {
+protected:
+	enum {
+		kFactor = 1 << shift,
+		kRound = kFactor / 2,
+		kChannels = stereo ? 2 : 1
+	};
+
+	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
+	const st_sample_t *inPtr;
+	int inLen;
+
+	/** next output frame between the last and current input frame, kFactor when done */
+	int phase;
+
+	/** last sample(s) in the input stream (left/right channel) */
+	st_sample_t ilast0, ilast1;
+	/** current sample(s) in the input stream (left/right channel) */
+	st_sample_t icur0, icur1;
+
+	void nextFrame() {
+		inLen -= kChannels;
+		ilast0 = icur0;
+		icur0 = *inPtr++;
+		if (stereo) {
+			ilast1 = icur1;
+			icur1 = *inPtr++;
+		}
+		phase = 0;
+	}
+
+	template<bool unity>
+	st_sample_t *finishFrame(st_sample_t *obuf, st_sample_t *oend, int vol_l, int vol_r) {
+		const int d0 = icur0 - ilast0;
+		const int d1 = icur1 - ilast1;
+		for (; phase < kFactor && obuf < oend; ++phase, obuf += 2) {
+			const int out0 = ilast0 + ((d0 * phase + kRound) >> shift);
+			mixFrame<reverseStereo, unity>(obuf, out0, stereo ? ilast1 + ((d1 * phase + kRound) >> shift) : out0, vol_l, vol_r);
+		}
+		return obuf;
+	}
+
+	template<bool unity>
+	st_sample_t *expand(st_sample_t *obuf, uint frames, int vol_l, int vol_r) {
+		while (frames--) {
+			nextFrame();
+			const int d0 = icur0 - ilast0;
+			const int d1 = icur1 - ilast1;
+			for (int k = 0; k < kFactor; ++k, obuf += 2) {
+				const int out0 = ilast0 + ((d0 * k + kRound) >> shift);
+				mixFrame<reverseStereo, unity>(obuf, out0, stereo ? ilast1 + ((d1 * k + kRound) >> shift) : out0, vol_l, vol_r);
+			}
+		}
+		phase = kFactor;
+		return obuf;
+	}
+
+	template<bool unity>
+	int flowInternal(AudioStream &input, st_sample_t *obuf, st_size_t osamp, int vol_l, int vol_r) {
+		st_sample_t *ostart = obuf;
+		st_sample_t *oend = obuf + osamp * 2;
+
+		// Complete the input frame the previous call stopped in.
+		obuf = finishFrame<unity>(obuf, oend, vol_l, vol_r);
+
+		while (obuf < oend) {
+			if (inLen == 0) {
+				inPtr = inBuf;
+				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+				if (inLen <= 0) {
+					inLen = 0;
+					break;
+				}
+			}
+
+			// Expand as many whole input frames as fit into the output.
+			const uint frames = MIN<uint>(inLen / kChannels, (oend - obuf) >> (shift + 1));
+			if (frames) {
+				obuf = expand<unity>(obuf, frames, vol_l, vol_r);
+			} else {
+				nextFrame();
+				obuf = finishFrame<unity>(obuf, oend, vol_l, vol_r);
+			}
+		}
+
+		return (obuf - ostart) / 2;
+	}
+
+public:
+	UpsamplingRateConverter() : inPtr(inBuf), inLen(0), phase(kFactor), ilast0(0), ilast1(0), icur0(0), icur1(0) {
+		assert(Audio::Mixer::kMaxMixerVolume == 1 << VOLUME_SHIFT);
+	}
+
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		assert(input.isStereo() == stereo);
+
+		if (vol_l == Audio::Mixer::kMaxMixerVolume && vol_r == Audio::Mixer::kMaxMixerVolume)
+			return flowInternal<true>(input, obuf, osamp, vol_l, vol_r);
+		else
+			return flowInternal<false>(input, obuf, osamp, vol_l, vol_r);
+	}
+
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+		return ST_SUCCESS;
+	}
+};
+
+
+#pragma mark -
+
+
 /**
  * Simple audio rate converter for the case that the inrate equals the outrate.
  */
@@ -316,6 +458,16 @@ public:
 
 		// Mix the data into the output buffer
 		ptr = _buffer;
+		if (vol_l == Audio::Mixer::kMaxMixerVolume && vol_r == Audio::Mixer::kMaxMixerVolume) {
+			// Unity gain, nothing to scale.
+			for (; len > 0; len -= (stereo ? 2 : 1)) {
+				st_sample_t out0 = *ptr++;
+				mixFrame<reverseStereo, true>(obuf, out0, stereo ? *ptr++ : out0, vol_l, vol_r);
+				obuf += 2;
+			}
+			return (obuf - ostart) / 2;
+		}
+
 		for (; len > 0; len -= (stereo ? 2 : 1)) {
 			st_sample_t out0, out1;
 			out0 = *ptr++;
@@ -341,9 +493,13 @@ public:
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool fastPaths) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0 && (inrate < 65536)) {
+		if (fastPaths && outrate == inrate * 2) {
+			return new UpsamplingRateConverter<stereo, reverseStereo, 1>();
+		} else if (fastPaths && outrate == inrate * 4) {
+			return new UpsamplingRateConverter<stereo, reverseStereo, 2>();
+		} else if ((inrate % outrate) == 0 && (inrate < 65536)) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -356,14 +512,14 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, bool fastPaths) {
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, fastPaths);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, fastPaths);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, fastPaths);
 }
 
 } // End of namespace Audio
@@ -78,7 +78,13 @@ public:
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * Create and return a RateConverter object for the specified input and output rates.
+ *
+ * @param fastPaths allow the block based converters for upsampling by exactly
+ *                  2 or 4; only turned off to compare against them
+ */
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, bool fastPaths = true);
 
 } // End of namespace Audio
 
@@ -24,6 +24,7 @@
  */
 
 #include "backends/mixer/amigaos3/amigaos3-mixer.h"
+#include "audio/mixer_ring.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/system.h"
@@ -53,6 +54,10 @@ static Audio::MixerImpl *g_mixer = NULL;
 static struct Task *g_soundThread = NULL;
 static struct Task *g_mainThread = NULL;
 
+// Only used when the "mixer_latency" setting asks for mixing ahead.
+static Audio::MixerRingBuffer *g_ring = NULL;
+static struct Task *g_producerThread = NULL;
+
 AmigaOS3MixerManager::AmigaOS3MixerManager() {
 #ifndef NDEBUG
 	debug(9, "AmigaOS3MixerManager::AmigaOS3MixerManager()");
@@ -73,6 +78,21 @@ AmigaOS3MixerManager::~AmigaOS3MixerManager() {
 			g_soundThread = NULL;
 		}
 
+		if (g_producerThread) {
+			Signal(g_producerThread, SIGBREAKF_CTRL_C);
+			Wait(SIGBREAKF_CTRL_F);
+			g_producerThread = NULL;
+		}
+
+		if (g_ring) {
+#ifndef NDEBUG
+			debug(1, "Mixer ring: %u blocks mixed, %u underruns (%u samples)",
+				  g_ring->getBlocksMixed(), g_ring->getUnderruns(), g_ring->getUnderrunSamples());
+#endif
+			delete g_ring;
+			g_ring = NULL;
+		}
+
 		delete g_mixer;
 		g_mixer = NULL;
 	}
@@ -173,6 +193,32 @@ bool init_scummvm_sound() {
 	return true;
 }
 
+static int mix_scummvm_sound(byte *samples, uint len) {
+	if (!g_ring)
+		return g_mixer->mixCallback(samples, len);
+
+	int mixedSamples = g_ring->consume(samples, len);
+
+	// Blocks were freed, let the producer mix ahead again.
+	Signal(g_producerThread, SIGBREAKF_CTRL_E);
+
+	// Silent blocks may sit between audible ones, so play the whole buffer.
+	return mixedSamples ? len / 4 : 0;
+}
+
+void __stdargs __saveds scummvm_mixer_producer_thread() {
+	for (;;) {
+		g_ring->produce();
+
+		ULONG signals = Wait(SIGBREAKF_CTRL_C | SIGBREAKF_CTRL_E);
+		if (signals & SIGBREAKF_CTRL_C) {
+			break;
+		}
+	}
+
+	Signal(g_mainThread, SIGBREAKF_CTRL_F);
+}
+
 void __stdargs __saveds scummvm_sound_thread() {
 	// int __saveds scummvm_sound_thread(void) {
 	LONG priority = 0;
@@ -199,7 +245,7 @@ void __stdargs __saveds scummvm_sound_thread() {
 
 //			ahiReq[_currentSoundBuffer]->ahir_Std.io_Length = _sampleBufferSize;
 
-			int mixedSamples = g_mixer->mixCallback((byte *)soundBuffer[_currentSoundBuffer], _sampleBufferSize);
+			int mixedSamples = mix_scummvm_sound((byte *)soundBuffer[_currentSoundBuffer], _sampleBufferSize);
 			if (mixedSamples) {
 				ahiReq[_currentSoundBuffer]->ahir_Std.io_Length = mixedSamples * 4;
 				SendIO((struct IORequest *)ahiReq[_currentSoundBuffer]);
@@ -292,6 +338,37 @@ void AmigaOS3MixerManager::init(int priority) {
 
 	g_mainThread=FindTask(NULL);
 
+	// Optionally mix ahead in a separate producer task, so the sound thread
+	// never waits for the mixer mutex. The ring has to hold at least two
+	// AHI buffers worth of blocks.
+	uint32 latency = 0;
+	if (ConfMan.hasKey("mixer_latency")) {
+		latency = ConfMan.getInt("mixer_latency");
+	}
+
+	if (latency) {
+		const uint blockSamples = _sampleCount / 4;
+		const uint numBlocks = MAX<uint>(Audio::MixerRingBuffer::blocksForLatency(latency, _mixingFrequency, blockSamples), 8);
+
+		g_ring = new Audio::MixerRingBuffer(g_mixer, blockSamples, numBlocks);
+		g_ring->produce();
+
+		g_producerThread =
+		  (Task *)CreateNewProcTags(NP_Name, (ULONG) "ScummVM MixerProducer", NP_CloseOutput, FALSE, NP_CloseInput, FALSE,
+									NP_StackSize, 20000, NP_Entry, (ULONG)&scummvm_mixer_producer_thread, TAG_DONE);
+
+		if (!g_producerThread) {
+			warning("Could not create the mixer producer thread, mixing in the sound thread");
+			delete g_ring;
+			g_ring = NULL;
+		} else {
+#ifndef NDEBUG
+			debug(1, "Mixing ahead %u blocks of %u samples", numBlocks, blockSamples);
+#endif
+			SetTaskPri(g_producerThread, priority);
+		}
+	}
+
 	g_soundThread =
 	  (Task *)CreateNewProcTags(NP_Name, (ULONG) "ScummVM MixerThread", NP_CloseOutput, FALSE, NP_CloseInput, FALSE,
 								NP_StackSize, 20000, NP_Entry, (ULONG)&scummvm_sound_thread, TAG_DONE);
@@ -310,3 +387,7 @@ void AmigaOS3MixerManager::init(int priority) {
 Audio::Mixer *AmigaOS3MixerManager::getMixer() {
 	return g_mixer;
 }
+
+const Audio::MixerRingBuffer *AmigaOS3MixerManager::getRingBuffer() const {
+	return g_ring;
+}
@@ -3,6 +3,10 @@
 
 #include "audio/mixer_intern.h"
 
+namespace Audio {
+class MixerRingBuffer;
+}
+
 class AmigaOS3MixerManager {
 public:
 	AmigaOS3MixerManager();
@@ -11,6 +15,12 @@ public:
 	virtual void init(int priority);
 
 	Audio::Mixer* getMixer();
+
+	/**
+	 * Return the ring the mixer mixes ahead into, or NULL when the sound
+	 * thread calls the mixer directly. Useful for reading underrun counts.
+	 */
+	const Audio::MixerRingBuffer *getRingBuffer() const;
 };
 
 #endif
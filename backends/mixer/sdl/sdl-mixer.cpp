@@ -41,7 +41,11 @@
 SdlMixerManager::SdlMixerManager()
 	:
 	_mixer(0),
-	_audioSuspended(false) {
+	_audioSuspended(false),
+	_ring(0),
+	_producerThread(0),
+	_producerSem(0),
+	_producerQuit(false) {
 
 }
 
@@ -50,6 +54,8 @@ SdlMixerManager::~SdlMixerManager() {
 
 	SDL_CloseAudio();
 
+	stopProducer();
+
 	delete _mixer;
 }
 
@@ -122,9 +128,86 @@ void SdlMixerManager::init() {
 	assert(_mixer);
 	_mixer->setReady(true);
 
+	// Optionally mix ahead in a separate thread, so the audio callback
+	// never waits for the mixer mutex.
+	const char *const appDomain = Common::ConfigManager::kApplicationDomain;
+	if (ConfMan.hasKey("mixer_latency", appDomain)) {
+		int latency = ConfMan.getInt("mixer_latency", appDomain);
+		if (latency > 0)
+			startProducer(latency);
+	}
+
 	startAudio();
 }
 
+void SdlMixerManager::startProducer(uint32 latencyMs) {
+	// Blocks of half a callback buffer, and enough of them to always have
+	// two callbacks worth of samples ready.
+	const uint blockSamples = MAX<uint>(_obtained.samples / 2, 64);
+	const uint numBlocks = MAX<uint>(Audio::MixerRingBuffer::blocksForLatency(latencyMs, _obtained.freq, blockSamples), 4);
+
+	_producerSem = SDL_CreateSemaphore(0);
+	if (!_producerSem) {
+		warning("Could not create mixer producer semaphore: %s", SDL_GetError());
+		return;
+	}
+
+	_ring = new Audio::MixerRingBuffer(_mixer, blockSamples, numBlocks);
+	_ring->produce();
+	_producerQuit = false;
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	_producerThread = SDL_CreateThread(producerThread, "ScummVM mixer producer", this);
+#else
+	_producerThread = SDL_CreateThread(producerThread, this);
+#endif
+	if (!_producerThread) {
+		warning("Could not create mixer producer thread: %s", SDL_GetError());
+		delete _ring;
+		_ring = 0;
+		SDL_DestroySemaphore(_producerSem);
+		_producerSem = 0;
+		return;
+	}
+
+	debug(1, "Mixing ahead %d blocks of %d samples", numBlocks, blockSamples);
+}
+
+void SdlMixerManager::stopProducer() {
+	if (_producerThread) {
+		_producerQuit = true;
+		SDL_SemPost(_producerSem);
+		SDL_WaitThread(_producerThread, NULL);
+		_producerThread = 0;
+	}
+
+	if (_producerSem) {
+		SDL_DestroySemaphore(_producerSem);
+		_producerSem = 0;
+	}
+
+	if (_ring) {
+		debug(1, "Mixer ring: %d blocks mixed, %d underruns (%d samples)",
+			  _ring->getBlocksMixed(), _ring->getUnderruns(), _ring->getUnderrunSamples());
+		delete _ring;
+		_ring = 0;
+	}
+}
+
+int SdlMixerManager::producerThread(void *this_) {
+	SdlMixerManager *manager = (SdlMixerManager *)this_;
+
+	while (!manager->_producerQuit) {
+		manager->_ring->produce();
+
+		// Woken up whenever the callback frees blocks; the timeout only
+		// guards against a device that stopped calling back.
+		SDL_SemWaitTimeout(manager->_producerSem, 100);
+	}
+
+	return 0;
+}
+
 static uint32 roundDownPowerOfTwo(uint32 samples) {
 	// Public domain code from Sean Eron Anderson
 	// http://graphics.stanford.edu/~seander/bithacks.html#RoundUpPowerOf2
@@ -195,6 +278,12 @@ void SdlMixerManager::startAudio() {
 
 void SdlMixerManager::callbackHandler(byte *samples, int len) {
 	assert(_mixer);
+	if (_ring) {
+		_ring->consume(samples, len);
+		SDL_SemPost(_producerSem);
+		return;
+	}
+
 	_mixer->mixCallback(samples, len);
 }
 
@@ -25,6 +25,7 @@
 
 #include "backends/platform/sdl/sdl-sys.h"
 #include "audio/mixer_intern.h"
+#include "audio/mixer_ring.h"
 
 /**
  * SDL mixer manager. It wraps the actual implementation
@@ -47,6 +48,12 @@ public:
 	 */
 	Audio::Mixer *getMixer() { return (Audio::Mixer *)_mixer; }
 
+	/**
+	 * Get the ring the mixer mixes ahead into, or NULL when the audio
+	 * callback calls the mixer directly
+	 */
+	const Audio::MixerRingBuffer *getRingBuffer() const { return _ring; }
+
 	// Used by Event recorder
 
 	/**
@@ -72,6 +79,30 @@ protected:
 	/** State of the audio system */
 	bool _audioSuspended;
 
+	/**
+	 * Ring of mixed blocks, used when the "mixer_latency" setting asks
+	 * for mixing ahead in a separate producer thread
+	 */
+	Audio::MixerRingBuffer *_ring;
+	SDL_Thread *_producerThread;
+	SDL_sem *_producerSem;
+	volatile bool _producerQuit;
+
+	/**
+	 * Sets up the ring and producer thread for the given latency
+	 */
+	void startProducer(uint32 latencyMs);
+
+	/**
+	 * Stops the producer thread and frees the ring
+	 */
+	void stopProducer();
+
+	/**
+	 * The producer thread entry point
+	 */
+	static int producerThread(void *this_);
+
 	/**
 	 * Returns the desired audio specification
 	 */
@@ -45,7 +45,7 @@ static UWORD emptypointer[] = {
 
 #define OSYSAGA OSystemAGA
 
-OSYSAGA::OSystemAGA() {
+OSYSAGA::OSystemAGA(bool nativeC2P) : _nativeC2P(nativeC2P) {
 	// gDebugLevel = 11;
 
 	_inited = false;
@@ -77,6 +77,12 @@ OSYSAGA::OSystemAGA() {
 
 	_overlayVisible = true;
 	_overlayColorMap = NULL;
+
+	// Only rewrite the bitplane words that actually change, chip RAM
+	// writes are expensive.
+	for (unsigned s = 0; s < NUM_SCREENBUFFERS; ++s) {
+		_c2p[s].setDeltaMode(true);
+	}
 }
 
 OSYSAGA::~OSystemAGA() {
@@ -413,9 +419,6 @@ bool OSYSAGA::loadGFXMode() {
 	// Create the surface that contains the 8 bit game data
 	_screen.create(_videoMode.screenWidth, _videoMode.screenHeight, Graphics::PixelFormat::createFormatCLUT8());
 
-	// Create the screen used by the scaler/shaker.
-	_tmpscreen.create(_videoMode.screenWidth, _videoMode.screenHeight, Graphics::PixelFormat::createFormatCLUT8());
-
 	// Create the 8bit overlay surface
 	_overlayscreen8.create(_videoMode.screenWidth, _videoMode.overlayScreenHeight,
 						   Graphics::PixelFormat::createFormatCLUT8());
@@ -423,6 +426,15 @@ bool OSYSAGA::loadGFXMode() {
 	// Create the 16bit overlay surface
 	_overlayscreen16.create(_videoMode.screenWidth, _videoMode.overlayScreenHeight, _overlayFormat);
 
+	// Both buffers need a full update first. The chunky to planar conversion
+	// works on 32 pixel groups, so keep the updated areas aligned to them.
+	for (unsigned s = 0; s < NUM_SCREENBUFFERS; ++s) {
+		_bufferDirtyRects[s].setAlignment(32);
+		_bufferDirtyRects[s].setBounds(_videoMode.screenWidth, _videoMode.overlayScreenHeight);
+		_c2p[s].invalidate();
+	}
+	_lastMouseRect = Common::Rect();
+
 	return true;
 }
 
@@ -455,7 +467,6 @@ struct Window *OSYSAGA::createHardwareWindow(uint16 width, uint16 height, struct
 
 void OSYSAGA::unloadGFXMode() {
 	_screen.free();
-	_tmpscreen.free();
 
 	_overlayscreen8.free();
 	_overlayscreen16.free();
@@ -569,6 +580,10 @@ void OSYSAGA::copyRectToScreen(const void *buf, int pitch, int x, int y, int w,
 	assert(w > 0 && x + w <= _videoMode.screenWidth);
 #endif
 
+	if (!_overlayVisible) {
+		addDirtyRect(Common::Rect(x, y, x + w, y + h));
+	}
+
 	byte *dst = (byte *)_screen.getBasePtr(x, y);
 
 	if (_videoMode.screenWidth == pitch && pitch == w) {
@@ -586,6 +601,43 @@ void OSYSAGA::copyRectToScreen(const void *buf, int pitch, int x, int y, int w,
 void OSYSAGA::fillScreen(uint32 col) {
 	if (_screen.getPixels()) {
 		memset(_screen.getPixels(), (int)col, ((unsigned)_videoMode.screenWidth * _videoMode.screenHeight));
+
+		if (!_overlayVisible) {
+			markAllDirty();
+		}
+	}
+}
+
+void OSYSAGA::addDirtyRect(const Common::Rect &r) {
+	for (unsigned s = 0; s < NUM_SCREENBUFFERS; ++s) {
+		_bufferDirtyRects[s].addRect(r);
+	}
+}
+
+void OSYSAGA::markAllDirty() {
+	for (unsigned s = 0; s < NUM_SCREENBUFFERS; ++s) {
+		_bufferDirtyRects[s].markAll();
+	}
+}
+
+void OSYSAGA::writeChunkyArea(const Graphics::Surface &src, const Common::Rect &r) {
+	struct RastPort *rastPort = &_screenRastPorts[_currentScreenBuffer];
+
+	if (_nativeC2P) {
+		struct BitMap *bitMap = rastPort->BitMap;
+
+		Graphics::PlanarBitmap planar;
+		planar.bytesPerRow = bitMap->BytesPerRow;
+		planar.rows = bitMap->Rows;
+		planar.depth = bitMap->Depth;
+		for (unsigned p = 0; p < 8; ++p) {
+			planar.planes[p] = (byte *)bitMap->Planes[p];
+		}
+
+		_c2p[_currentScreenBuffer].convert(src, r, planar);
+	} else {
+		WriteChunkyPixels(rastPort, r.left, r.top, r.right - 1, r.bottom - 1, (UBYTE *)src.getBasePtr(r.left, r.top),
+						  src.pitch);
 	}
 }
 
@@ -594,39 +646,91 @@ void OSYSAGA::updateScreen() {
 	debug(9, "OSystem_AmigaOS3::updateScreen()");
 #endif
 
-	static UBYTE *src;
+	// The game wrote to the locked screen, we don't know where.
+	if (_screenDirty) {
+		if (!_overlayVisible) {
+			markAllDirty();
+		}
+		_screenDirty = false;
+	}
+
+	if (_currentShakePos != _newShakePos) {
+		_currentShakePos = _newShakePos;
+
+		if (!_overlayVisible) {
+			markAllDirty();
+		}
+
+		// The black area below the shaken screen is not written by the
+		// converters.
+		for (unsigned s = 0; s < NUM_SCREENBUFFERS; ++s) {
+			_c2p[s].invalidate();
+		}
+	}
+
+	Common::Rect mouseRect;
 
 	if (_mouseCursor.visible) {
 		drawMouse();
+
+		mouseRect = Common::Rect(_mouseCursorMask.x, _mouseCursorMask.y, _mouseCursorMask.x + _mouseCursorMask.w,
+								 _mouseCursorMask.y + _mouseCursorMask.h);
 	}
 
-	if (_overlayVisible) {
-		src = (UBYTE *)_overlayscreen8.getPixels();
-		assert(_videoMode.overlayWidth <= _videoMode.screenWidth);
-		assert(_videoMode.overlayHeight <= _videoMode.overlayScreenHeight);
-		WriteChunkyPixels(&_screenRastPorts[_currentScreenBuffer], 0, 0, _videoMode.overlayWidth - 1,
-						  _videoMode.overlayHeight - 1, src, _videoMode.overlayWidth);
-	} else {
-		if (_currentShakePos != _newShakePos) {
-			// Set the 'dirty area' to black.
-			memset(_tmpscreen.getBasePtr(0, (_videoMode.screenHeight - _newShakePos)), 0,
-				   (_videoMode.screenWidth * _newShakePos));
+	// Both where the cursor was and where it is now need an update.
+	if (mouseRect != _lastMouseRect) {
+		addDirtyRect(_lastMouseRect);
+		addDirtyRect(mouseRect);
+		_lastMouseRect = mouseRect;
+	}
+
+	Graphics::DirtyRectList &dirtyRects = _bufferDirtyRects[_currentScreenBuffer];
+	const bool needsFlip = !dirtyRects.empty();
 
-			src = (UBYTE *)_screen.getBasePtr(0, _newShakePos);
-			byte *dst = (byte *)_tmpscreen.getBasePtr(0, 0);
+	if (needsFlip) {
+		struct RastPort *rastPort = &_screenRastPorts[_currentScreenBuffer];
+		const Common::Array<Common::Rect> &rects = dirtyRects.getRects();
 
-			CopyMemQuick(src, dst, (_videoMode.screenWidth * (_videoMode.screenHeight - _newShakePos)));
+		if (_overlayVisible) {
+			assert(_videoMode.overlayWidth <= _videoMode.screenWidth);
+			assert(_videoMode.overlayHeight <= _videoMode.overlayScreenHeight);
 
-			// Reset.
-			_currentShakePos = _newShakePos;
+			for (uint i = 0; i < rects.size(); ++i) {
+				Common::Rect r = rects[i];
+				r.clip(_videoMode.overlayWidth, _videoMode.overlayHeight);
+				if (r.isEmpty()) {
+					continue;
+				}
 
-			src = (UBYTE *)_tmpscreen.getPixels();
+				writeChunkyArea(_overlayscreen8, r);
+			}
 		} else {
-			src = (UBYTE *)_screen.getPixels();
+			// Rows of the game screen are shown _currentShakePos rows higher,
+			// the rows uncovered at the bottom are black.
+			const int16 shake = _currentShakePos;
+			const Graphics::Surface shown =
+				_screen.getSubArea(Common::Rect(0, shake, _videoMode.screenWidth, _videoMode.screenHeight));
+
+			for (uint i = 0; i < rects.size(); ++i) {
+				Common::Rect r = rects[i];
+				r.translate(0, -shake);
+				r.clip(shown.w, shown.h);
+				if (r.isEmpty()) {
+					continue;
+				}
+
+				writeChunkyArea(shown, r);
+			}
+
+			// Shaking always marks everything dirty.
+			if (shake > 0 && dirtyRects.isAllDirty()) {
+				SetAPen(rastPort, 0);
+				RectFill(rastPort, 0, _videoMode.screenHeight - shake, _videoMode.screenWidth - 1,
+						 _videoMode.screenHeight - 1);
+			}
 		}
 
-		WriteChunkyPixels(&_screenRastPorts[_currentScreenBuffer], 0, 0, _videoMode.screenWidth - 1,
-						  _videoMode.screenHeight - 1, src, _videoMode.screenWidth);
+		dirtyRects.clear();
 	}
 
 	// Check whether the palette was changed.
@@ -638,7 +742,9 @@ void OSYSAGA::updateScreen() {
 		undrawMouse();
 	}
 
-	if (ChangeScreenBuffer(_hardwareScreen, _hardwareScreenBuffer[_currentScreenBuffer])) {
+	// Nothing changed in the back buffer, so it's no different from what is
+	// shown right now.
+	if (needsFlip && ChangeScreenBuffer(_hardwareScreen, _hardwareScreenBuffer[_currentScreenBuffer])) {
 		// Flip.
 		_currentScreenBuffer = (_currentScreenBuffer + 1) % NUM_SCREENBUFFERS;
 	}
@@ -722,6 +828,7 @@ void OSYSAGA::showOverlay() {
 	}
 
 	_overlayVisible = true;
+	markAllDirty();
 
 	// Make a backup of the current game palette.
 	memcpy(_gamePalette, _currentPalette, PALETTE_SIZE);
@@ -749,9 +856,11 @@ void OSYSAGA::hideOverlay() {
 		ClearScreen(&_screenRastPorts[_currentScreenBuffer]);
 		ChangeScreenBuffer(_hardwareScreen, _hardwareScreenBuffer[_currentScreenBuffer]);
 		_currentScreenBuffer = (_currentScreenBuffer + 1) % NUM_SCREENBUFFERS;
+		_c2p[s].invalidate();
 	}
 
 	_overlayVisible = false;
+	markAllDirty();
 
 	// Reset the game palette.
 	setPalette((byte *)_gamePalette, 0, 256);
@@ -765,6 +874,8 @@ void OSYSAGA::clearOverlay() {
 	// Set the background to black.
 	byte *src = (byte *)_overlayscreen8.getPixels();
 	memset(src, 0, (_videoMode.screenWidth * _videoMode.overlayScreenHeight));
+
+	markAllDirty();
 }
 
 void OSYSAGA::grabOverlay(void *buf, int pitch) {
@@ -800,6 +911,10 @@ void OSYSAGA::copyRectToOverlay(const void *buf, int _pitch, int _x, int _y, int
 		return;
 	}
 
+	if (_overlayVisible) {
+		addDirtyRect(Common::Rect(x, y, x + w, y + h));
+	}
+
 	const OverlayColor *src = (const OverlayColor *)buf;
 	byte *dst = (byte *)_overlayscreen8.getBasePtr(x, y);
 
@@ -882,6 +997,9 @@ void OSYSAGA::setMouseCursor(const void *buf, uint w, uint h, int hotspot_x, int
 	_mouseCursor.keyColor = keycolor;
 
 	CopyMem((void *)buf, _mouseCursor.surface.getPixels(), (unsigned)w * h);
+
+	// The new image may have the same size and position as the old one.
+	addDirtyRect(_lastMouseRect);
 }
 
 void OSYSAGA::setMouseCursorPosition(uint16 x, uint16 y) {
@@ -930,7 +1048,9 @@ void OSYSAGA::drawMouse() {
 	}
 
 	if (w <= 0 || h <= 0) {
-		// Nothing to do.
+		// Nothing to do, and nothing to restore in undrawMouse().
+		_mouseCursorMask.w = 0;
+		_mouseCursorMask.h = 0;
 		return;
 	}
 
@@ -441,9 +441,6 @@ bool OSYSCGX::loadGFXMode() {
 	// Create the surface that contains the 8 bit game data
 	_screen.create(_videoMode.screenWidth, _videoMode.screenHeight, Graphics::PixelFormat::createFormatCLUT8());
 
-	// Create the screen used by the scaler/shaker.
-	_tmpscreen.create(_videoMode.screenWidth, _videoMode.screenHeight, Graphics::PixelFormat::createFormatCLUT8());
-
 	// Create the 8bit overlay surface
 	_overlayscreen8.create(_videoMode.overlayWidth, _videoMode.overlayHeight,
 						   Graphics::PixelFormat::createFormatCLUT8());
@@ -451,8 +448,13 @@ bool OSYSCGX::loadGFXMode() {
 	// Create the 16bit overlay surface
 	_overlayscreen16.create(_videoMode.overlayWidth, _videoMode.overlayHeight, _overlayFormat);
 
-	_screenDirty = true;
-	_overlayDirty = true;
+	// Everything needs to be copied first. Keeping the copied areas
+	// longword aligned allows for CopyMemQuick().
+	_screenDirtyRects.setAlignment(4);
+	_screenDirtyRects.setBounds(_videoMode.screenWidth, _videoMode.screenHeight);
+	_overlayDirtyRects.setAlignment(4);
+	_overlayDirtyRects.setBounds(_videoMode.overlayWidth, _videoMode.overlayHeight);
+	_lastMouseRect = Common::Rect();
 
 	return true;
 }
@@ -519,7 +521,6 @@ struct Window *OSYSCGX::createHardwareWindow(uint16 width, uint16 height, struct
 
 void OSYSCGX::unloadGFXMode() {
 	_screen.free();
-	_tmpscreen.free();
 
 	_overlayscreen8.free();
 	_overlayscreen16.free();
@@ -638,6 +639,8 @@ void OSYSCGX::copyRectToScreen(const void *buf, int pitch, int x, int y, int w,
 	/*if (_videoMode.screenWidth == pitch && pitch == w) {
 		CopyMemQuick((byte*)buf, dst, w * h);
 		} else {*/
+	_screenDirtyRects.addRect(Common::Rect(x, y, x + w, y + h));
+
 	const byte *src = (const byte *)buf;
 	do {
 		CopyMem((void *)src, dst, w);
@@ -645,14 +648,12 @@ void OSYSCGX::copyRectToScreen(const void *buf, int pitch, int x, int y, int w,
 		dst += _videoMode.bytesPerRow;
 	} while (--h);
 	//}
-
-	_screenDirty = true;
 }
 
 void OSYSCGX::fillScreen(uint32 col) {
 	if (_screen.getPixels()) {
 		memset(_screen.getPixels(), (int)col, (_videoMode.bytesPerRow * _videoMode.screenHeight));
-		_screenDirty = true;
+		_screenDirtyRects.markAll();
 	}
 }
 
@@ -661,84 +662,94 @@ void OSYSCGX::updateScreen() {
 	debug(9, "OSystem_AmigaOS3::updateScreen()");
 #endif
 
-	UBYTE *src;
+	// The game wrote to the locked screen, we don't know where.
+	if (_screenDirty) {
+		_screenDirtyRects.markAll();
+		_screenDirty = false;
+	}
 
-	if (_overlayVisible && _overlayDirty) {
-		if (_mouseCursor.visible) {
-			drawMouse();
-		}
+	if (_currentShakePos != _newShakePos) {
+		_currentShakePos = _newShakePos;
+		_screenDirtyRects.markAll();
+	}
 
-		UBYTE *base_address;
-		APTR video_bitmap_handle = LockBitMapTags(_hardwareOverlayScreen->ViewPort.RasInfo->BitMap, LBMI_BASEADDRESS,
-												  (ULONG)&base_address, TAG_DONE);
-		if (video_bitmap_handle) {
-			// CopyMemQuick((UBYTE*)_overlayscreen8.getPixels(), base_address, (_videoMode.overlayWidth *
-			// _videoMode.overlayHeight));
+	Graphics::DirtyRectList &dirtyRects = _overlayVisible ? _overlayDirtyRects : _screenDirtyRects;
 
-			UBYTE *dst = base_address;
-			UBYTE *src = (UBYTE *)_overlayscreen8.getPixels();
+	Common::Rect mouseRect;
 
-			for (uint r = 0; r < _videoMode.overlayHeight; r++) {
-				CopyMem(src, dst, _videoMode.overlayWidth);
+	if (_mouseCursor.visible) {
+		drawMouse();
 
-				// add a row.
-				dst += (_videoMode.overlayBytesPerRow);
-				src += (_videoMode.overlayWidth);
-			}
-
-			UnLockBitMap(video_bitmap_handle);
-			video_bitmap_handle = NULL;
-		}
+		mouseRect = Common::Rect(_mouseCursorMask.x, _mouseCursorMask.y, _mouseCursorMask.x + _mouseCursorMask.w,
+								 _mouseCursorMask.y + _mouseCursorMask.h);
+	}
 
-		if (_mouseCursor.visible) {
-			undrawMouse();
-		}
+	// Both where the cursor was and where it is now need an update.
+	if (mouseRect != _lastMouseRect) {
+		dirtyRects.addRect(_lastMouseRect);
+		dirtyRects.addRect(mouseRect);
+		_lastMouseRect = mouseRect;
+	}
 
-		_overlayDirty = false;
-	} else if (_screenDirty) {
-		if (_mouseCursor.visible) {
-			drawMouse();
+	if (!dirtyRects.empty()) {
+		if (_overlayVisible) {
+			copyDirtyRects(_hardwareOverlayScreen, (const byte *)_overlayscreen8.getPixels(), _videoMode.overlayWidth,
+						   _videoMode.overlayBytesPerRow, 0, dirtyRects);
+		} else {
+			copyDirtyRects(_hardwareGameScreen, (const byte *)_screen.getPixels(), _videoMode.bytesPerRow,
+						   _videoMode.bytesPerRow, _currentShakePos, dirtyRects);
 		}
 
-		if (_currentShakePos != _newShakePos) {
-			// Set the 'dirty area' to black.
-			/*memset(_tmpscreen.getBasePtr(0, (_videoMode.screenHeight - _newShakePos)), 0, (_videoMode.bytesPerRow *
-			_newShakePos));
+		dirtyRects.clear();
+	}
 
-			src = (UBYTE*)_screen.getBasePtr(0, _newShakePos);
-			byte *dst = (byte*)_tmpscreen.getBasePtr(0, 0);
+	if (_mouseCursor.visible) {
+		undrawMouse();
+	}
 
-			// TODO
-			CopyMemQuick(src, dst, (_videoMode.bytesPerRow * (_videoMode.screenHeight - _newShakePos)));
+	// Check whether the palette was changed.
+	if (_paletteDirtyEnd != 0) {
+		updatePalette();
+	}
+}
 
-			// Reset.
-			_currentShakePos = _newShakePos;*/
+void OSYSCGX::copyDirtyRects(struct Screen *screen, const byte *src, uint srcPitch, uint dstPitch, int16 shake,
+							 const Graphics::DirtyRectList &dirtyRects) {
+	_copySpans.clear();
+
+	if (shake > 0) {
+		// Rows are shown shake rows higher, the rows uncovered at the bottom
+		// are black. Shaking always marks everything dirty.
+		Common::Array<Common::Rect> shaken;
+		shaken.push_back(Common::Rect(_videoMode.screenWidth, _videoMode.screenHeight - shake));
+		Graphics::computeCopySpans(shaken, 1, srcPitch, dstPitch, _copySpans);
+		src += shake * srcPitch;
+	} else {
+		Graphics::computeCopySpans(dirtyRects.getRects(), 1, srcPitch, dstPitch, _copySpans);
+	}
 
-			src = (UBYTE *)_tmpscreen.getPixels();
-		} else {
-			src = (UBYTE *)_screen.getPixels();
-		}
+	UBYTE *baseAddress;
+	APTR videoBitmapHandle =
+		LockBitMapTags(screen->ViewPort.RasInfo->BitMap, LBMI_BASEADDRESS, (ULONG)&baseAddress, TAG_DONE);
+	if (!videoBitmapHandle) {
+		return;
+	}
 
-		UBYTE *base_address;
-		APTR video_bitmap_handle = LockBitMapTags(_hardwareGameScreen->ViewPort.RasInfo->BitMap, LBMI_BASEADDRESS,
-												  (ULONG)&base_address, TAG_DONE);
-		if (video_bitmap_handle) {
-			CopyMemQuick(src, base_address, (_videoMode.bytesPerRow * _videoMode.screenHeight));
-			UnLockBitMap(video_bitmap_handle);
-			video_bitmap_handle = NULL;
-		}
+	for (uint i = 0; i < _copySpans.size(); ++i) {
+		const Graphics::CopySpan &span = _copySpans[i];
 
-		if (_mouseCursor.visible) {
-			undrawMouse();
+		if (((span.srcOffset | span.dstOffset | span.length) & 3) == 0) {
+			CopyMemQuick((APTR)(src + span.srcOffset), baseAddress + span.dstOffset, span.length);
+		} else {
+			CopyMem((APTR)(src + span.srcOffset), baseAddress + span.dstOffset, span.length);
 		}
-
-		_screenDirty = false;
 	}
 
-	// Check whether the palette was changed.
-	if (_paletteDirtyEnd != 0) {
-		updatePalette();
+	if (shake > 0) {
+		memset(baseAddress + (_videoMode.screenHeight - shake) * dstPitch, 0, shake * dstPitch);
 	}
+
+	UnLockBitMap(videoBitmapHandle);
 }
 
 void OSYSCGX::setShakePos(int shakeX, int shakeY) {
@@ -746,7 +757,7 @@ void OSYSCGX::setShakePos(int shakeX, int shakeY) {
 	assert(_transactionMode == kTransactionNone);
 #endif
 
-	_newShakePos = shakeX;
+	_newShakePos = shakeY;
 }
 
 #pragma mark -
@@ -822,6 +833,10 @@ void OSYSCGX::showOverlay() {
 	ScreenToFront(_hardwareOverlayScreen);
 	ActivateWindow(_hardwareOverlayWindow);
 
+	// The cursor stays on the game screen until it's updated next.
+	_screenDirtyRects.addRect(_lastMouseRect);
+	_lastMouseRect = Common::Rect();
+
 	_overlayVisible = true;
 }
 
@@ -845,11 +860,14 @@ void OSYSCGX::hideOverlay() {
 					 (_videoMode.overlayWidth * _videoMode.overlayHeight));
 		UnLockBitMap(video_bitmap_handle);
 		video_bitmap_handle = NULL;
+		_overlayDirtyRects.clear();
 	}
 
 	ScreenToFront(_hardwareGameScreen);
 	ActivateWindow(_hardwareGameWindow);
 
+	_lastMouseRect = Common::Rect();
+
 	_overlayVisible = false;
 }
 
@@ -861,7 +879,7 @@ void OSYSCGX::clearOverlay() {
 	// Set the background to black.
 	byte *src = (byte *)_overlayscreen8.getPixels();
 	memset(src, 0, (_videoMode.overlayWidth * _videoMode.overlayHeight));
-	_overlayDirty = true;
+	_overlayDirtyRects.markAll();
 }
 
 void OSYSCGX::grabOverlay(void *buf, int pitch) {
@@ -926,7 +944,7 @@ void OSYSCGX::copyRectToOverlay(const void *buf, int pitch, int x, int y, int w,
 		src += (_videoMode.overlayWidth - w);
 	}
 
-	_overlayDirty = true;
+	_overlayDirtyRects.addRect(Common::Rect(x, y, x + w, y + h));
 }
 
 struct Window *OSYSCGX::getHardwareWindow() {
@@ -946,14 +964,6 @@ bool OSYSCGX::showMouse(bool visible) {
 		return visible;
 	}
 
-	if (_mouseCursor.visible != visible) {
-		if (_overlayVisible) {
-			_overlayDirty = true;
-		} else {
-			_screenDirty = true;
-		}
-	}
-
 	bool last = _mouseCursor.visible;
 	_mouseCursor.visible = visible;
 
@@ -997,37 +1007,25 @@ void OSYSCGX::setMouseCursor(const void *buf, uint w, uint h, int hotspot_x, int
 		_mouseCursorMask.surface.create(w, h, Graphics::PixelFormat::createFormatCLUT8());
 	}
 
-	MouseCursor oldMouseCursor = _mouseCursor;
-
 	_mouseCursor.w = w;
 	_mouseCursor.h = h;
 	_mouseCursor.hotX = hotspot_x;
 	_mouseCursor.hotY = hotspot_y;
 	_mouseCursor.keyColor = keycolor;
 
-	if (memcmp(&oldMouseCursor, &_mouseCursor, sizeof(MouseCursor)) != 0) {
-		if (_overlayVisible) {
-			_overlayDirty = true;
-		} else {
-			_screenDirty = true;
-		}
-	}
 	CopyMem((void *)buf, _mouseCursor.surface.getPixels(), w * h);
+
+	// The new image may have the same size and position as the old one.
+	if (_overlayVisible) {
+		_overlayDirtyRects.addRect(_lastMouseRect);
+	} else {
+		_screenDirtyRects.addRect(_lastMouseRect);
+	}
 }
 
 void OSYSCGX::setMouseCursorPosition(uint16 x, uint16 y) {
-	MouseCursor oldMouseCursor = _mouseCursor;
-
 	_mouseCursor.x = x;
 	_mouseCursor.y = y;
-
-	if (memcmp(&oldMouseCursor, &_mouseCursor, sizeof(MouseCursor)) != 0) {
-		if (_overlayVisible) {
-			_overlayDirty = true;
-		} else {
-			_screenDirty = true;
-		}
-	}
 }
 
 void OSYSCGX::drawMouse() {
@@ -1075,7 +1073,9 @@ void OSYSCGX::drawMouse() {
 	}
 
 	if (w <= 0 || h <= 0) {
-		// Nothing to do.
+		// Nothing to do, and nothing to restore in undrawMouse().
+		_mouseCursorMask.w = 0;
+		_mouseCursorMask.h = 0;
 		return;
 	}
 
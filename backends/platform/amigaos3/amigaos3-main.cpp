@@ -144,6 +144,7 @@ __stdargs int main(int argcWb, char const * argvWb[]) {
 	int audioThreadPriority = DEFAULT_AUDIO_THREAD_PRIORITY;
 	int closeWb = 0;
 	int forceAGA = 0;
+	int nativeC2P = 0;
 
 	struct Task * task = FindTask(NULL);
 	ptrdiff_t ss = (char*)task->tc_SPUpper - (char*)task->tc_SPLower;
@@ -178,6 +179,12 @@ __stdargs int main(int argcWb, char const * argvWb[]) {
 				printf("Forcing AGA backend.\n");
 			}
 
+			toolType = (STRPTR)FindToolType(diskObject->do_ToolTypes, "NATIVE_C2P");
+			if (toolType != NULL) {
+				nativeC2P = 1;
+				printf("Using built-in chunky to planar conversion.\n");
+			}
+
 			toolType = (STRPTR)FindToolType(diskObject->do_ToolTypes, "CLOSE_WB");
 			if (toolType != NULL)
 				closeWb = 1;
@@ -195,7 +202,7 @@ __stdargs int main(int argcWb, char const * argvWb[]) {
 		sys = new OSystemCGX();
 	}
 	else {
-		sys = new OSystemAGA();
+		sys = new OSystemAGA(nativeC2P);
 	}
 	g_system = sys;
 	assert(g_system);
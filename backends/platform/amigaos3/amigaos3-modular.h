@@ -36,6 +36,8 @@
 
 #include "common/scummsys.h"
 #include "common/system.h"
+#include "graphics/c2p.h"
+#include "graphics/dirtyrects.h"
 #include "graphics/palette.h"
 #include "graphics/surface.h"
 
@@ -123,7 +125,6 @@ protected:
 
 	/** Unseen game screen */
 	Graphics::Surface _screen;
-	Graphics::Surface _tmpscreen;
 
 	// Loading screen.
 	// Graphics::Surface* _splashSurface;
@@ -168,6 +169,13 @@ protected:
 	bool _overlayDirty;
 	bool _mouseDirty;
 
+	/**
+	 * Areas each screen buffer still has to be updated in. Every change is
+	 * added to all buffers, and a buffer's list is emptied once the areas
+	 * were written to it.
+	 */
+	Graphics::DirtyRectList _bufferDirtyRects[NUM_SCREENBUFFERS];
+
 	// Mouse data.
 	struct MouseCursor {
 		MouseCursor() : visible(false), keyColor(0), w(0), h(0), x(0), y(0), hotX(0), hotY(0) {}
@@ -195,6 +203,9 @@ protected:
 
 	MouseCursorMask _mouseCursorMask;
 
+	/** Where the cursor was drawn during the last update, empty if it was not. */
+	Common::Rect _lastMouseRect;
+
 	// Palette data
 	byte *_currentPalette;
 	byte *_gamePalette;
@@ -220,7 +231,7 @@ protected:
 
 class OSystemAGA : public OSystem_AmigaOS3_Modular {
 public:
-	OSystemAGA();
+	OSystemAGA(bool nativeC2P = false);
 	virtual ~OSystemAGA();
 
 	virtual bool hasFeature(OSystem::Feature f) override;
@@ -288,6 +299,10 @@ public:
 	void drawMouse();
 	void undrawMouse();
 
+	void addDirtyRect(const Common::Rect &r);
+	void markAllDirty();
+	void writeChunkyArea(const Graphics::Surface &src, const Common::Rect &r);
+
 	bool loadGFXMode();
 	ULONG loadModeId();
 	void saveModeId(ULONG modeId);
@@ -296,6 +311,11 @@ public:
 	struct Window *createHardwareWindow(uint16 width, uint16 height, struct Screen *screen);
 	void unloadGFXMode();
 	void updatePalette();
+
+protected:
+	/** Convert with Graphics::ChunkyToPlanar instead of WriteChunkyPixels */
+	bool _nativeC2P;
+	Graphics::ChunkyToPlanar _c2p[NUM_SCREENBUFFERS];
 };
 
 class OSystemCGX : public OSystem_AmigaOS3_Modular {
@@ -376,6 +396,19 @@ public:
 	struct Window *createHardwareWindow(uint16 width, uint16 height, struct Screen *screen);
 	void unloadGFXMode();
 	void updatePalette();
+
+	void copyDirtyRects(struct Screen *screen, const byte *src, uint srcPitch, uint dstPitch, int16 shake,
+						const Graphics::DirtyRectList &dirtyRects);
+
+protected:
+	/**
+	 * Areas of the game and overlay screens that differ from what the
+	 * hardware screens show. Each list is kept while the other screen is
+	 * visible.
+	 */
+	Graphics::DirtyRectList _screenDirtyRects;
+	Graphics::DirtyRectList _overlayDirtyRects;
+	Common::Array<Graphics::CopySpan> _copySpans;
 };
 
 #endif
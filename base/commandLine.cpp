@@ -152,7 +152,9 @@ static const char HELP_STRING[] =
 	"                           atari, macintosh)\n"
 #ifdef ENABLE_EVENTRECORDER
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
-	"                           passthrough [default])\n"
+	"                           fast_playback, passthrough [default])\n"
+	"                           fast_playback replays headless without waiting and\n"
+	"                           reports frame times and a hash of the final screen\n"
 	"  --record-file-name=FILE  Specify record file name\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
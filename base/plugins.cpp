@@ -26,6 +26,12 @@
 #include "common/func.h"
 #include "common/debug.h"
 #include "common/config-manager.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/stream.h"
+#include "common/tokenizer.h"
+
+#include "engines/metaengine.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
@@ -261,6 +267,7 @@ void PluginManager::addPluginProvider(PluginProvider *pp) {
 void PluginManagerUncached::init() {
 	unloadAllPlugins();
 	_allEnginePlugins.clear();
+	_pluginStamps.clear();
 
 	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, NULL, false); // empty the engine plugins
 
@@ -287,6 +294,24 @@ void PluginManagerUncached::init() {
 			}
  		}
  	}
+
+	// Forget about plugin files which are gone
+	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_cache");
+	if (domain) {
+		Common::StringArray staleFiles;
+		for (Common::ConfigManager::Domain::const_iterator i = domain->begin(); i != domain->end(); ++i) {
+			PluginList::iterator p;
+			for (p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+				if ((*p)->getFileName() && i->_key.equalsIgnoreCase((*p)->getFileName()))
+					break;
+			}
+			if (p == _allEnginePlugins.end())
+				staleFiles.push_back(i->_key);
+		}
+		for (Common::StringArray::iterator i = staleFiles.begin(); i != staleFiles.end(); ++i)
+			domain->erase(*i);
+		_pluginCacheChanged = !staleFiles.empty();
+	}
 }
 
 /**
@@ -305,6 +330,19 @@ bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineI
 			}
 		}
 	}
+
+	// Otherwise look for the engine in the plugin cache. The entry was
+	// picked by the quick stamp, so check all of the file before trusting
+	// it, and leave it to the caller's scan when it changed after all.
+	for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		Common::StringArray entry;
+		if ((*p)->getFileName() && getCacheEntry((*p)->getFileName(), entry) && entry[1] == engineId) {
+			if (!verifyCacheEntry((*p)->getFileName(), entry))
+				return false;
+
+			return loadPluginByFileName((*p)->getFileName());
+		}
+	}
 	return false;
 }
 
@@ -322,6 +360,7 @@ bool PluginManagerUncached::loadPluginByFileName(const Common::String &filename)
 		if (Common::String((*i)->getFileName()) == filename && (*i)->loadPlugin()) {
 			addToPluginsInMemList(*i);
 			_currentPlugin = i;
+			updatePluginCache(*i);
 			return true;
 		}
 	}
@@ -353,6 +392,7 @@ void PluginManagerUncached::loadFirstPlugin() {
 	for (_currentPlugin = _allEnginePlugins.begin(); _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			updatePluginCache(*_currentPlugin);
 			break;
 		}
 	}
@@ -367,12 +407,144 @@ bool PluginManagerUncached::loadNextPlugin() {
 	for (++_currentPlugin; _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			updatePluginCache(*_currentPlugin);
 			return true;
 		}
 	}
+	flushPluginCache();
 	return false; // no more in list
 }
 
+bool PluginManagerUncached::getCachedEngineIds(const Common::String &gameId, Common::StringArray &engineIds) {
+	engineIds.clear();
+
+	for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		Common::StringArray entry;
+		if (!(*p)->getFileName() || !getCacheEntry((*p)->getFileName(), entry))
+			return false;
+
+		for (uint i = 2; i < entry.size(); ++i) {
+			if (entry[i].equalsIgnoreCase(gameId)) {
+				engineIds.push_back(entry[1]);
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Identify the contents of a plugin file cheaply by its size and the MD5 of
+ * its first and last few KB. This is enough to tell which plugins changed
+ * without reading all of them; the plugin about to be loaded is checked in
+ * full by verifyCacheEntry().
+ **/
+Common::String PluginManagerUncached::getPluginStamp(const Common::String &filename) {
+	StampMap::const_iterator i = _pluginStamps.find(filename);
+	if (i != _pluginStamps.end())
+		return i->_value;
+
+	Common::String stamp;
+	Common::SeekableReadStream *stream = Common::FSNode(filename).createReadStream();
+	if (stream) {
+		const uint32 kChunkSize = 4096;
+		const int32 size = MAX<int32>(stream->size(), 0);
+		const uint32 headSize = MIN<int32>(size, kChunkSize);
+		const uint32 tailSize = MIN<int32>(size - headSize, kChunkSize);
+
+		byte *buffer = new byte[headSize + tailSize];
+		stream->read(buffer, headSize);
+		stream->seek(size - tailSize);
+		stream->read(buffer + headSize, tailSize);
+
+		if (!stream->err()) {
+			Common::MemoryReadStream chunks(buffer, headSize + tailSize);
+			stamp = Common::String::format("%d:", size) + Common::computeStreamMD5AsString(chunks);
+		}
+		delete[] buffer;
+		delete stream;
+	}
+	_pluginStamps[filename] = stamp;
+	return stamp;
+}
+
+/**
+ * Get the MD5 of a whole plugin file, which completes its stamp.
+ **/
+Common::String PluginManagerUncached::getPluginFileMD5(const Common::String &filename) {
+	Common::String md5;
+	Common::SeekableReadStream *stream = Common::FSNode(filename).createReadStream();
+	if (stream) {
+		md5 = Common::computeStreamMD5AsString(*stream);
+		delete stream;
+	}
+	return md5;
+}
+
+/**
+ * Check a cache entry found by getCacheEntry() against all of the plugin
+ * file. Entries which do not match are removed.
+ **/
+bool PluginManagerUncached::verifyCacheEntry(const Common::String &filename, const Common::StringArray &entry) {
+	const Common::String md5 = getPluginFileMD5(filename);
+	if (!md5.empty() && entry[0] == getPluginStamp(filename) + ":" + md5)
+		return true;
+
+	ConfMan.getDomain("engine_plugin_cache")->erase(filename);
+	_pluginCacheChanged = true;
+	return false;
+}
+
+/**
+ * Get the cache entry of a plugin file, split into the file stamp, the
+ * engine ID and the supported game IDs. Entries of files whose quick stamp
+ * changed are not returned.
+ **/
+bool PluginManagerUncached::getCacheEntry(const Common::String &filename, Common::StringArray &entry) {
+	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_cache");
+	if (!domain || !domain->contains(filename))
+		return false;
+
+	entry.clear();
+	Common::StringTokenizer tokenizer(domain->getVal(filename), " ");
+	while (!tokenizer.empty())
+		entry.push_back(tokenizer.nextToken());
+
+	return entry.size() >= 2 && entry[0].hasPrefix(getPluginStamp(filename) + ":");
+}
+
+void PluginManagerUncached::updatePluginCache(const Plugin *plugin) {
+	Common::StringArray entry;
+	if (!plugin->getFileName() || plugin->getType() != PLUGIN_TYPE_ENGINE || getCacheEntry(plugin->getFileName(), entry))
+		return;
+
+	const Common::String stamp = getPluginStamp(plugin->getFileName());
+	const Common::String md5 = getPluginFileMD5(plugin->getFileName());
+	if (stamp.empty() || md5.empty())
+		return;
+
+	const MetaEngine &metaEngine = plugin->get<MetaEngine>();
+	Common::String value = stamp + ":" + md5 + " " + metaEngine.getEngineId();
+	PlainGameList games = metaEngine.getSupportedGames();
+	for (PlainGameList::const_iterator g = games.begin(); g != games.end(); ++g)
+		value += Common::String(" ") + g->gameId;
+
+	if (!ConfMan.hasMiscDomain("engine_plugin_cache"))
+		ConfMan.addMiscDomain("engine_plugin_cache");
+
+	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_cache");
+	assert(domain);
+	(*domain)[plugin->getFileName()] = value;
+	_pluginCacheChanged = true;
+}
+
+void PluginManagerUncached::flushPluginCache() {
+	if (_pluginCacheChanged) {
+		ConfMan.flushToDisk();
+		_pluginCacheChanged = false;
+	}
+}
+
 /**
  * Used by only the cached plugin manager. The uncached manager can only have
  * one plugin in memory at a time.
@@ -504,6 +676,16 @@ QualifiedGameList EngineManager::findGamesMatching(const Common::String &engineI
 		}
 	}
 	} else {
+		// Only load the plugins known to support the game, if any. Should
+		// none of them find it after all, their entries were out of date.
+		Common::StringArray engineIds;
+		if (PluginMan.getCachedEngineIds(gameId, engineIds) && !engineIds.empty()) {
+			for (Common::StringArray::const_iterator i = engineIds.begin(); i != engineIds.end(); ++i)
+				results.push_back(findGamesMatching(*i, gameId));
+			if (!results.empty())
+				return results;
+		}
+
 		// This is a slow path, we have to scan the list of plugins
 	PluginMan.loadFirstPlugin();
 	do {
@@ -25,7 +25,10 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/str.h"
+#include "common/str-array.h"
 #include "backends/plugins/elf/version.h"
 
 #define INCLUDED_FROM_BASE_PLUGINS_H
@@ -321,6 +324,7 @@ public:
 	virtual bool loadNextPlugin() { return false; }
 	virtual bool loadPluginFromEngineId(const Common::String &engineId) { return false; }
 	virtual void updateConfigWithFileName(const Common::String &engineId) {}
+	virtual bool getCachedEngineIds(const Common::String &gameId, Common::StringArray &engineIds) { return false; }
 
 	// Functions used only by the cached PluginManager
 	virtual void loadAllPlugins();
@@ -335,16 +339,33 @@ public:
 /**
  *  Uncached version of plugin manager
  *  Keeps only one dynamic plugin in memory at a time
+ *
+ *  To avoid loading every plugin just to find out which engine and games it
+ *  provides, this is remembered per plugin file in the 'engine_plugin_cache'
+ *  config domain, together with a stamp of the file to notice when it changed.
+ *  The stamp has a quick part to pick plugins by, and the MD5 of the whole
+ *  file which is only checked for the plugin that gets loaded.
  **/
 class PluginManagerUncached : public PluginManager {
 protected:
 	friend class PluginManager;
+	typedef Common::HashMap<Common::String, Common::String> StampMap;
+
 	PluginList _allEnginePlugins;
 	PluginList::iterator _currentPlugin;
+	StampMap _pluginStamps;
+	bool _pluginCacheChanged;
 
-	PluginManagerUncached() {}
+	PluginManagerUncached() : _pluginCacheChanged(false) {}
 	bool loadPluginByFileName(const Common::String &filename);
 
+	Common::String getPluginStamp(const Common::String &filename);
+	Common::String getPluginFileMD5(const Common::String &filename);
+	bool getCacheEntry(const Common::String &filename, Common::StringArray &entry);
+	bool verifyCacheEntry(const Common::String &filename, const Common::StringArray &entry);
+	void updatePluginCache(const Plugin *plugin);
+	void flushPluginCache();
+
 public:
 	virtual void init();
 	virtual void loadFirstPlugin();
@@ -352,6 +373,15 @@ public:
 	virtual bool loadPluginFromEngineId(const Common::String &engineId);
 	virtual void updateConfigWithFileName(const Common::String &engineId);
 
+	/**
+	 * Look up which engines support the given game ID, without loading any
+	 * plugin.
+	 *
+	 * @return false if the plugins are not all known, so they need to be
+	 *         scanned
+	 */
+	virtual bool getCachedEngineIds(const Common::String &gameId, Common::StringArray &engineIds);
+
 	virtual void loadAllPlugins() {} 	// we don't allow these
 	virtual void loadAllPluginsOfType(PluginType type) {}
 };
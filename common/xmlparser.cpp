@@ -22,6 +22,7 @@
 
 #include "common/xmlparser.h"
 #include "common/archive.h"
+#include "common/array.h"
 #include "common/fs.h"
 #include "common/memstream.h"
 #include "common/system.h"
@@ -80,6 +81,14 @@ void XMLParser::close() {
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
+	if (_binary) {
+		// There is no text to quote, so name the key instead.
+		Common::String errorMessage = Common::String::format("\n  File <%s>, key '%s':\n\nParser error: %s\n\n",
+			_fileName.c_str(), _activeKey.empty() ? "" : _activeKey.top()->name.c_str(), errStr.c_str());
+		g_system->logMessage(LogMessageType::kError, errorMessage.c_str());
+		return false;
+	}
+
 	const int startPosition = _stream->pos();
 	int currentPosition = startPosition;
 	int lineCount = 1;
@@ -169,7 +178,7 @@ bool XMLParser::parseActiveKey(bool closed) {
 	if (layout->children.contains(key->name)) {
 		key->layout = layout->children[key->name];
 
-		StringMap localMap = key->values;
+		const StringMap &localMap = key->values;
 		int keyCount = localMap.size();
 
 		for (List<XMLKeyLayout::XMLKeyProperty>::const_iterator i = key->layout->properties.begin(); i != key->layout->properties.end(); ++i) {
@@ -313,6 +322,12 @@ bool XMLParser::parse() {
 
 	cleanup();
 
+	_binary = (_stream->readUint32BE() == MKTAG('B', 'X', 'M', 'L'));
+	if (_binary)
+		return parseBinary();
+
+	_stream->seek(0, SEEK_SET);
+
 	bool activeClosure = false;
 	bool activeHeader = false;
 	bool selfClosure;
@@ -462,6 +477,87 @@ bool XMLParser::parse() {
 	return true;
 }
 
+bool XMLParser::parseBinary() {
+	_state = kParserNeedKey;
+
+	const uint16 version = _stream->readUint16LE();
+	if (version != kBinaryVersion)
+		return parserError(String::format("Unsupported binary version %d.", version));
+
+	// Skip the size and MD5 of the text this was created from
+	_stream->skip(4 + 16);
+
+	const uint16 stringCount = _stream->readUint16LE();
+	Array<String> strings;
+	strings.resize(stringCount);
+
+	Array<char> buffer;
+	for (uint i = 0; i < stringCount; ++i) {
+		const uint16 length = _stream->readUint16LE();
+		buffer.resize(length + 1);
+		_stream->read(buffer.begin(), length);
+		strings[i] = String(buffer.begin(), length);
+	}
+
+	if (_stream->err() || _stream->eos())
+		return parserError("Unexpected end of file.");
+
+	for (;;) {
+		const byte type = _stream->readByte();
+		if (_stream->eos())
+			return parserError("Unexpected end of file.");
+
+		if (type == kBinaryEnd)
+			break;
+
+		if (type == kBinaryKeyEnd) {
+			if (_activeKey.empty())
+				return parserError("Unexpected closure.");
+
+			if (!closeKey())
+				return parserError("Missing data when closing key '" + _activeKey.top()->name + "'.");
+
+			continue;
+		}
+
+		if (type != kBinaryKey && type != kBinaryClosedKey)
+			return parserError(String::format("Invalid record type %d.", type));
+
+		const uint16 name = _stream->readUint16LE();
+		if (name >= stringCount)
+			return parserError("Invalid key name.");
+
+		ParserNode *node = allocNode();
+		node->name = strings[name];
+		node->ignore = false;
+		node->header = false;
+		node->depth = _activeKey.size();
+		node->layout = nullptr;
+		_activeKey.push(node);
+
+		for (byte count = _stream->readByte(); count > 0; --count) {
+			const uint16 key = _stream->readUint16LE();
+			const uint16 value = _stream->readUint16LE();
+			// Like parseKeyValue(), reject keys given twice
+			if (key >= stringCount || value >= stringCount || node->values.contains(strings[key]))
+				return parserError("Invalid key value.");
+
+			node->values[strings[key]] = strings[value];
+		}
+
+		if (_stream->eos())
+			return parserError("Unexpected end of file.");
+
+		if (!parseActiveKey(type == kBinaryClosedKey))
+			return false;
+	}
+
+	if (!_activeKey.empty())
+		return parserError("Unexpected end of file.");
+
+	return true;
+}
+
 bool XMLParser::skipSpaces() {
 	if (!isSpace(_char))
 		return false;
@@ -85,6 +85,25 @@ class SeekableReadStream;
  * In order to use it, it must be inherited with a child class that implements
  * the XMLParser::keyCallback() function.
  *
+ * Besides text, the parser reads a binary form of the same files, in which
+ * keys and properties are already split up, so none of the text has to be
+ * tokenized. It is recognized by its "BXML" tag and laid out as follows,
+ * all numbers being little endian:
+ *
+ *   uint32 tag, uint16 version (kBinaryVersion)
+ *   uint32 size and 16 byte MD5 of the text file it was created from
+ *   uint16 number of strings, then for each: uint16 length, characters
+ *   records until kBinaryEnd:
+ *     kBinaryKey or kBinaryClosedKey: uint16 name, uint8 number of
+ *       properties, then for each: uint16 name, uint16 value
+ *     kBinaryKeyEnd
+ *
+ * Names and values are indices into the strings. A kBinaryKey record is
+ * closed by a later kBinaryKeyEnd, a kBinaryClosedKey record closes itself.
+ * gui/themes/scummtheme.py creates such files from theme STX files. The
+ * parser ignores the size and MD5 of the text; they let callers that keep
+ * both files notice when the binary one is out of date.
+ *
  * @see XMLParser::keyCallback()
  */
 class XMLParser {
@@ -92,10 +111,23 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _binary(false) {}
 
 	virtual ~XMLParser();
 
+	/** Record types and version of the binary format */
+	enum {
+		kBinaryEnd = 0,
+		kBinaryKey = 1,
+		kBinaryClosedKey = 2,
+		kBinaryKeyEnd = 3,
+
+		kBinaryVersion = 2,
+
+		/** Size of the tag, version and source size and MD5 */
+		kBinaryHeaderSize = 4 + 2 + 4 + 16
+	};
+
 	/** Active state for the parser */
 	enum ParserState {
 		kParserNeedHeader,
@@ -187,6 +219,11 @@ public:
 	 */
 	bool parse();
 
+	/**
+	 * Returns whether the last parsed stream was in the binary format.
+	 */
+	bool isBinary() const { return _binary; }
+
 	/**
 	 * Returns the active node being parsed (the one on top of
 	 * the node stack).
@@ -327,6 +364,11 @@ protected:
 
 	bool parseXMLHeader(ParserNode *node);
 
+	/**
+	 * Parses the rest of a stream in the binary format, after its tag.
+	 */
+	bool parseBinary();
+
 	/**
 	 * Overload if your parser needs to support parsing the same file
 	 * several times, so you can clean up the internal state of the
@@ -340,6 +382,7 @@ private:
 	char _char;
 	SeekableReadStream *_stream;
 	String _fileName;
+	bool _binary; /** Whether the stream is in the binary format */
 
 	ParserState _state; /** Internal state of the parser */
 
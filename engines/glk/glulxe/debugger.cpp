@@ -0,0 +1,60 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "glk/glulxe/debugger.h"
+#include "glk/glulxe/glulxe.h"
+
+namespace Glk {
+namespace Glulxe {
+
+Debugger::Debugger() : Glk::Debugger() {
+	registerCmd("undo", WRAP_METHOD(Debugger, cmdUndo));
+}
+
+bool Debugger::cmdUndo(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Format: undo [reset]\n");
+		return true;
+	}
+
+	undostats_t stats;
+	g_vm->get_undo_stats(&stats);
+
+	debugPrintf("%u undo levels using %u of %u bytes, plus %u bytes of RAM\n",
+		stats.levels, stats.chain_bytes, stats.max_bytes, stats.ram_bytes);
+	if (stats.save_count)
+		debugPrintf("saveundo: %u calls, %u ms average, %u ms max\n",
+			stats.save_count, stats.save_time / stats.save_count, stats.save_time_max);
+	if (stats.restore_count)
+		debugPrintf("restoreundo: %u calls, %u ms average, %u ms max\n",
+			stats.restore_count, stats.restore_time / stats.restore_count, stats.restore_time_max);
+
+	if (argc == 2) {
+		g_vm->reset_undo_stats();
+		debugPrintf("Timings reset\n");
+	}
+
+	return true;
+}
+
+} // End of namespace Glulxe
+} // End of namespace Glk
@@ -0,0 +1,44 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GLK_GLULXE_DEBUGGER_H
+#define GLK_GLULXE_DEBUGGER_H
+
+#include "glk/debugger.h"
+
+namespace Glk {
+namespace Glulxe {
+
+class Debugger : public Glk::Debugger {
+private:
+	/**
+	 * Show the size of the undo chain and the time spent saving and restoring undo states
+	 */
+	bool cmdUndo(int argc, const char **argv);
+public:
+	Debugger();
+};
+
+} // End of namespace Glulxe
+} // End of namespace Glk
+
+#endif
@@ -21,6 +21,7 @@
  */
 
 #include "glk/glulxe/glulxe.h"
+#include "glk/glulxe/debugger.h"
 #include "common/config-manager.h"
 #include "common/translation.h"
 
@@ -44,11 +45,16 @@ Glulxe::Glulxe(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst,
 		// heap
 		heap_start(0), alloc_count(0), heap_head(nullptr), heap_tail(nullptr),
 		// serial
-		max_undo_level(8), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr), ramcache(nullptr),
+		max_undo_memory(1024 * 1024), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr),
+		undo_chain_bytes(0), undo_ram(nullptr), undo_ramlen(0), ramcache(nullptr),
 		// string
 		iosys_mode(0), iosys_rock(0), tablecache_valid(false), glkio_unichar_han_ptr(nullptr) {
 	g_vm = this;
 
+	if (ConfMan.hasKey("undo_memory"))
+		max_undo_memory = ConfMan.getInt("undo_memory") * 1024;
+	reset_undo_stats();
+
 	glkopInit();
 }
 
@@ -74,6 +80,10 @@ void Glulxe::runGame() {
 	profile_quit();
 }
 
+void Glulxe::createDebugger() {
+	setDebugger(new Debugger());
+}
+
 bool Glulxe::is_gamefile_valid() {
 	if (_gameFile.size() < 8) {
 		GUIErrorMessage(_("This is too short to be a valid Glulx file."));
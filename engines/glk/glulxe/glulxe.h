@@ -154,13 +154,23 @@ private:
 	 */
 
 	/**
-	 * This can be adjusted before startup by platform-specific startup code -- that is, preference code.
+	 * The most memory the undo chain may use; the oldest levels are dropped to stay below it. The most
+	 * recent level is always kept. This can be adjusted with the undo_memory setting, in kilobytes.
 	 */
-	int max_undo_level;
+	uint max_undo_memory;
 
 	int undo_chain_size;
 	int undo_chain_num;
-	byte **undo_chain;
+	undostate_t *undo_chain;
+	uint undo_chain_bytes;
+
+	/**
+	 * A copy of RAM (ramstart to endmem) as it was at the most recent level of the undo chain
+	 */
+	byte *undo_ram;
+	uint undo_ramlen;
+
+	undostats_t undo_stats;
 
 	/**
 	 * This will contain a copy of RAM (ramstate to endmem) as it exists in the game file.
@@ -352,6 +362,23 @@ protected:
 	 */
 
 	uint write_memstate(dest_t *dest);
+
+	/**
+	 * Write the XOR of the first len bytes of undo_ram against the current RAM, in the same format as
+	 * write_memstate(). Bytes beyond endmem count as zero.
+	 */
+	uint write_undo_memdelta(dest_t *dest, uint len);
+
+	/**
+	 * Apply a delta written by write_undo_memdelta() to undo_ram, turning it into the RAM it was written
+	 * against. Returns 0 for success.
+	 */
+	uint apply_undo_memdelta(const byte *delta, uint deltalen);
+
+	/**
+	 * Drop the oldest level of the undo chain
+	 */
+	void drop_oldest_undo();
 	uint write_heapstate(dest_t *dest, int portable);
 	uint write_stackstate(dest_t *dest, int portable);
 	uint read_memstate(dest_t *dest, uint chunklen);
@@ -403,6 +430,11 @@ public:
 	 */
 	void runGame() override;
 
+	/**
+	 * Create the debugger
+	 */
+	void createDebugger() override;
+
 	/**
 	 * Returns the running interpreter type
 	 */
@@ -943,6 +975,12 @@ public:
 	 */
 	uint perform_restoreundo();
 
+	/**
+	 * Get the state of the undo chain, and the timings since the last call to reset_undo_stats()
+	 */
+	void get_undo_stats(undostats_t *stats) const;
+	void reset_undo_stats();
+
 	uint perform_verify();
 
 	/**@}*/
@@ -389,6 +389,40 @@ struct dest_struct {
 };
 typedef dest_struct dest_t;
 
+/**
+ * One level of the undo chain. The memory of the most recent level is kept in full, every older level only
+ * stores how its memory differs from that of the next more recent level.
+ */
+struct undostate_struct {
+	/* The memory as the XOR against the next more recent level, in the run-length encoded format
+	   of the CMem chunk. nullptr for the most recent level. */
+	byte *memdelta;
+	uint memdeltalen;
+
+	/* The heap and stack chunks, as for a save to memory. */
+	byte *state;
+	uint statelen;
+};
+typedef undostate_struct undostate_t;
+
+/**
+ * Statistics about the undo chain, and the time spent saving and restoring undo states.
+ */
+struct undostats_struct {
+	uint levels;
+	uint chain_bytes;		///< Memory used by the levels
+	uint ram_bytes;			///< Memory used by the full copy of the most recent level's memory
+	uint max_bytes;			///< Limit for chain_bytes
+
+	uint save_count;
+	uint save_time;			///< Total milliseconds spent in saveundo
+	uint save_time_max;
+	uint restore_count;
+	uint restore_time;		///< Total milliseconds spent in restoreundo
+	uint restore_time_max;
+};
+typedef undostats_struct undostats_t;
+
 /**
  * These constants are defined in the Glulx spec.
  */
@@ -29,8 +29,9 @@ namespace Glulxe {
 
 bool Glulxe::init_serial() {
 	undo_chain_num = 0;
-	undo_chain_size = max_undo_level;
-	undo_chain = (unsigned char **)glulx_malloc(sizeof(unsigned char *) * undo_chain_size);
+	undo_chain_size = 8;
+	undo_chain_bytes = 0;
+	undo_chain = (undostate_t *)glulx_malloc(sizeof(undostate_t) * undo_chain_size);
 	if (!undo_chain)
 		return false;
 
@@ -56,13 +57,21 @@ void Glulxe::final_serial() {
 	if (undo_chain) {
 		int ix;
 		for (ix = 0; ix < undo_chain_num; ix++) {
-			glulx_free(undo_chain[ix]);
+			glulx_free(undo_chain[ix].memdelta);
+			glulx_free(undo_chain[ix].state);
 		}
 		glulx_free(undo_chain);
 	}
 	undo_chain = nullptr;
 	undo_chain_size = 0;
 	undo_chain_num = 0;
+	undo_chain_bytes = 0;
+
+	if (undo_ram) {
+		glulx_free(undo_ram);
+		undo_ram = nullptr;
+	}
+	undo_ramlen = 0;
 
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
@@ -73,16 +82,23 @@ void Glulxe::final_serial() {
 }
 
 uint Glulxe::perform_saveundo() {
-	dest_t dest;
+	dest_t dest, delta;
 	uint res;
-	uint memstart = 0, memlen = 0, heapstart = 0, heaplen = 0;
+	uint heapstart = 0, heaplen = 0;
 	uint stackstart = 0, stacklen = 0;
+	uint ramlen = endmem - ramstart;
+	uint32 starttime = g_system->getMillis();
 
 	/* The format for undo-saves is simpler than for saves on disk. We
-	   just have a memory chunk, a heap chunk, and a stack chunk, in
-	   that order. We skip the IFF chunk headers (although the size
-	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   just have a heap chunk and a stack chunk, in that order. We skip
+	   the IFF chunk headers (although the size fields are still there.)
+	   We also don't bother with IFF's 16-bit alignment.
+
+	   Memory isn't part of this. The most recent level keeps a full copy
+	   of RAM in undo_ram; when a new level is added, the previous one
+	   only keeps how its RAM differs from the new one. A turn usually
+	   changes little memory, so these deltas are small even for large
+	   games. */
 
 	if (undo_chain_size == 0)
 		return 1;
@@ -93,18 +109,16 @@ uint Glulxe::perform_saveundo() {
 	dest.ptr = nullptr;
 	dest.str = nullptr;
 
+	delta.ismem = true;
+	delta.size = 0;
+	delta.pos = 0;
+	delta.ptr = nullptr;
+	delta.str = nullptr;
+
 	res = 0;
 	if (res == 0) {
 		res = write_long(&dest, 0); /* space for chunk length */
 	}
-	if (res == 0) {
-		memstart = dest.pos;
-		res = write_memstate(&dest);
-		memlen = dest.pos - memstart;
-	}
-	if (res == 0) {
-		res = write_long(&dest, 0); /* space for chunk length */
-	}
 	if (res == 0) {
 		heapstart = dest.pos;
 		res = write_heapstate(&dest, false);
@@ -125,12 +139,6 @@ uint Glulxe::perform_saveundo() {
 		if (!dest.ptr)
 			res = 1;
 	}
-	if (res == 0) {
-		res = reposition_write(&dest, memstart - 4);
-	}
-	if (res == 0) {
-		res = write_long(&dest, memlen);
-	}
 	if (res == 0) {
 		res = reposition_write(&dest, heapstart - 4);
 	}
@@ -144,27 +152,78 @@ uint Glulxe::perform_saveundo() {
 		res = write_long(&dest, stacklen);
 	}
 
+	if (res == 0 && undo_chain_num > 0) {
+		/* The previous level now only needs to know how its RAM differs
+		   from the current one. */
+		res = write_undo_memdelta(&delta, undo_ramlen);
+		if (res == 0 && delta.pos) {
+			delta.ptr = (byte *)glulx_realloc(delta.ptr, delta.pos);
+			if (!delta.ptr)
+				res = 1;
+		}
+	}
+
+	if (res == 0 && undo_chain_num >= undo_chain_size) {
+		undostate_t *chain = (undostate_t *)glulx_realloc(undo_chain, 2 * undo_chain_size * sizeof(undostate_t));
+		if (chain) {
+			undo_chain = chain;
+			undo_chain_size *= 2;
+		} else {
+			res = 1;
+		}
+	}
+
+	/* This has to come last, as the previous level's RAM is gone once
+	   undo_ram is resized. */
+	if (res == 0 && undo_ramlen != ramlen) {
+		byte *ram = (byte *)glulx_realloc(undo_ram, ramlen);
+		if (ram) {
+			undo_ram = ram;
+			undo_ramlen = ramlen;
+		} else {
+			res = 1;
+		}
+	}
+
 	if (res == 0) {
 		/* It worked. */
-		if (undo_chain_num >= undo_chain_size) {
-			glulx_free(undo_chain[undo_chain_num - 1]);
-			undo_chain[undo_chain_num - 1] = nullptr;
+		memcpy(undo_ram, memmap + ramstart, ramlen);
+
+		if (undo_chain_num > 0) {
+			undo_chain[0].memdelta = delta.ptr;
+			undo_chain[0].memdeltalen = delta.pos;
+			undo_chain_bytes += delta.pos;
 		}
-		if (undo_chain_size > 1)
-			memmove(undo_chain + 1, undo_chain,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
-		undo_chain[0] = dest.ptr;
-		if (undo_chain_num < undo_chain_size)
-			undo_chain_num += 1;
+		delta.ptr = nullptr;
+
+		memmove(undo_chain + 1, undo_chain, undo_chain_num * sizeof(undostate_t));
+		undo_chain[0].memdelta = nullptr;
+		undo_chain[0].memdeltalen = 0;
+		undo_chain[0].state = dest.ptr;
+		undo_chain[0].statelen = dest.pos;
+		undo_chain_bytes += dest.pos;
+		undo_chain_num += 1;
 		dest.ptr = nullptr;
+
+		while (undo_chain_num > 1 && undo_chain_bytes > max_undo_memory)
+			drop_oldest_undo();
 	} else {
 		/* It didn't work. */
 		if (dest.ptr) {
 			glulx_free(dest.ptr);
 			dest.ptr = nullptr;
 		}
+		if (delta.ptr) {
+			glulx_free(delta.ptr);
+			delta.ptr = nullptr;
+		}
 	}
 
+	uint32 time = g_system->getMillis() - starttime;
+	undo_stats.save_count++;
+	undo_stats.save_time += time;
+	undo_stats.save_time_max = MAX(undo_stats.save_time_max, time);
+
 	return res;
 }
 
@@ -173,6 +232,7 @@ uint Glulxe::perform_restoreundo() {
 	uint res, val = 0;
 	uint heapsumlen = 0;
 	uint *heapsumarr = nullptr;
+	uint32 starttime;
 
 	/* If profiling is enabled and active then fail. */
 #if VM_PROFILING
@@ -183,19 +243,28 @@ uint Glulxe::perform_restoreundo() {
 	if (undo_chain_size == 0 || undo_chain_num == 0)
 		return 1;
 
+	starttime = g_system->getMillis();
+
 	dest.ismem = true;
 	dest.size = 0;
 	dest.pos = 0;
-	dest.ptr = undo_chain[0];
+	dest.ptr = undo_chain[0].state;
 	dest.str = nullptr;
 
-	res = 0;
-	if (res == 0) {
-		res = read_long(&dest, &val);
-	}
+	/* Put back the RAM of the most recent level, keeping the protected
+	   range as it is. */
+	heap_clear();
+
+	res = change_memsize(ramstart + undo_ramlen, false);
 	if (res == 0) {
-		res = read_memstate(&dest, val);
+		uint pos = ramstart;
+		uint protstart = CLIP(protectstart, ramstart, endmem);
+		uint protend = CLIP(protectend, protstart, endmem);
+
+		memcpy(memmap + pos, undo_ram, protstart - pos);
+		memcpy(memmap + protend, undo_ram + (protend - ramstart), endmem - protend);
 	}
+
 	if (res == 0) {
 		res = read_long(&dest, &val);
 	}
@@ -217,21 +286,142 @@ uint Glulxe::perform_restoreundo() {
 	}
 
 	if (res == 0) {
-		/* It worked. */
-		if (undo_chain_size > 1)
-			memmove(undo_chain, undo_chain + 1,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
+		/* It worked. The next level's RAM can be rebuilt from the RAM
+		   we just restored. */
+		if (undo_chain_num > 1) {
+			undostate_t &next = undo_chain[1];
+			res = apply_undo_memdelta(next.memdelta, next.memdeltalen);
+			if (res)
+				fatal_error("Unable to rebuild the previous undo state.");
+
+			undo_chain_bytes -= next.memdeltalen;
+			glulx_free(next.memdelta);
+			next.memdelta = nullptr;
+			next.memdeltalen = 0;
+		}
+
+		undo_chain_bytes -= undo_chain[0].statelen;
+		glulx_free(undo_chain[0].state);
 		undo_chain_num -= 1;
-		glulx_free(dest.ptr);
-		dest.ptr = nullptr;
-	} else {
-		/* It didn't work. */
-		dest.ptr = nullptr;
+		memmove(undo_chain, undo_chain + 1, undo_chain_num * sizeof(undostate_t));
 	}
+	dest.ptr = nullptr;
+
+	uint32 time = g_system->getMillis() - starttime;
+	undo_stats.restore_count++;
+	undo_stats.restore_time += time;
+	undo_stats.restore_time_max = MAX(undo_stats.restore_time_max, time);
 
 	return res;
 }
 
+void Glulxe::drop_oldest_undo() {
+	undostate_t &oldest = undo_chain[undo_chain_num - 1];
+
+	/* Nothing depends on the oldest level, since deltas only go from
+	   older levels to newer ones. */
+	undo_chain_bytes -= oldest.memdeltalen + oldest.statelen;
+	glulx_free(oldest.memdelta);
+	glulx_free(oldest.state);
+	undo_chain_num -= 1;
+}
+
+uint Glulxe::write_undo_memdelta(dest_t *dest, uint len) {
+	uint res, pos;
+	uint newlen = endmem - ramstart;
+	int val;
+	int runlen;
+	unsigned char ch;
+
+	res = write_long(dest, ramstart + len);
+	if (res)
+		return res;
+
+	runlen = 0;
+
+	for (pos = 0; pos < len; pos++) {
+		ch = undo_ram[pos];
+		if (pos < newlen)
+			ch ^= memmap[ramstart + pos];
+
+		if (ch == 0) {
+			runlen++;
+		} else {
+			/* Write any run we've got. */
+			while (runlen) {
+				if (runlen >= 0x100)
+					val = 0x100;
+				else
+					val = runlen;
+				res = write_byte(dest, 0);
+				if (res)
+					return res;
+				res = write_byte(dest, (val - 1));
+				if (res)
+					return res;
+				runlen -= val;
+			}
+			/* Write the byte we got. */
+			res = write_byte(dest, ch);
+			if (res)
+				return res;
+		}
+	}
+	/* It's possible we've got a run left over, but we don't write it. */
+
+	return 0;
+}
+
+uint Glulxe::apply_undo_memdelta(const byte *delta, uint deltalen) {
+	uint pos, dpos, len;
+	int runlen;
+
+	if (deltalen < 4)
+		return 1;
+	len = Read4(delta) - ramstart;
+	dpos = 4;
+
+	if (len != undo_ramlen) {
+		byte *ram = (byte *)glulx_realloc(undo_ram, len);
+		if (!ram)
+			return 1;
+		if (len > undo_ramlen)
+			memset(ram + undo_ramlen, 0, len - undo_ramlen);
+		undo_ram = ram;
+		undo_ramlen = len;
+	}
+
+	runlen = 0;
+
+	for (pos = 0; pos < len && dpos < deltalen; pos++) {
+		if (runlen) {
+			runlen--;
+		} else if (delta[dpos] == 0) {
+			if (dpos + 1 >= deltalen)
+				return 1;
+			runlen = delta[dpos + 1];
+			dpos += 2;
+		} else {
+			undo_ram[pos] ^= delta[dpos];
+			dpos++;
+		}
+	}
+
+	return 0;
+}
+
+void Glulxe::get_undo_stats(undostats_t *stats) const {
+	*stats = undo_stats;
+	stats->levels = undo_chain_num;
+	stats->chain_bytes = undo_chain_bytes;
+	stats->ram_bytes = undo_ramlen;
+	stats->max_bytes = max_undo_memory;
+}
+
+void Glulxe::reset_undo_stats() {
+	memset(&undo_stats, 0, sizeof(undo_stats));
+}
+
 Common::Error Glulxe::writeGameData(Common::WriteStream *ws) {
 #ifdef TODO
 	dest_t dest;
@@ -207,6 +207,7 @@ MODULE_OBJS := \
 	frotz/sound_folder.o \
 	frotz/windows.o \
 	glulxe/accel.o \
+	glulxe/debugger.o \
 	glulxe/detection.o \
 	glulxe/exec.o \
 	glulxe/float.o \
@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -100,6 +101,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("selectors",			WRAP_METHOD(Console, cmdSelectors));
 	registerCmd("functions",			WRAP_METHOD(Console, cmdKernelFunctions));
 	registerCmd("class_table",		WRAP_METHOD(Console, cmdClassTable));
+	registerCmd("avoidpath_stats",	WRAP_METHOD(Console, cmdAvoidPathStats));
 	// Parser
 	registerCmd("suffixes",			WRAP_METHOD(Console, cmdSuffixes));
 	registerCmd("parse_grammar",		WRAP_METHOD(Console, cmdParseGrammar));
@@ -117,6 +119,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -133,6 +136,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("set_palette",		WRAP_METHOD(Console, cmdSetPalette));
 	registerCmd("draw_pic",			WRAP_METHOD(Console, cmdDrawPic));
 	registerCmd("draw_cel",			WRAP_METHOD(Console, cmdDrawCel));
+	registerCmd("cel_bench",			WRAP_METHOD(Console, cmdCelBench));
 	registerCmd("undither",           WRAP_METHOD(Console, cmdUndither));
 	registerCmd("pic_visualize",		WRAP_METHOD(Console, cmdPicVisualize));
 	registerCmd("play_video",         WRAP_METHOD(Console, cmdPlayVideo));
@@ -163,6 +167,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -195,6 +200,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("sg",					WRAP_METHOD(Console, cmdStepGlobal));	// alias
 	registerCmd("step_callk",			WRAP_METHOD(Console, cmdStepCallk));
 	registerCmd("snk",				WRAP_METHOD(Console, cmdStepCallk));	// alias
+	registerCmd("vm_bench",			WRAP_METHOD(Console, cmdVMBench));
 	registerCmd("disasm",				WRAP_METHOD(Console, cmdDisassemble));
 	registerCmd("disasm_addr",		WRAP_METHOD(Console, cmdDisassembleAddress));
 	registerCmd("find_callk",			WRAP_METHOD(Console, cmdFindKernelFunctionCall));
@@ -256,6 +262,10 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+	_debugState.benchSteps = 0;
+	_debugState.benchStepsLeft = 0;
+	_debugState.benchStartTime = 0;
+	_debugState.benchDecodeScripts = false;
 }
 
 Console::~Console() {
@@ -328,6 +338,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" selector - Attempts to find the requested selector by name\n");
 	debugPrintf(" functions - Lists the kernel functions\n");
 	debugPrintf(" class_table - Shows the available classes\n");
+	debugPrintf(" avoidpath_stats - Shows pathfinding times and visibility graph reuse\n");
 	debugPrintf("\n");
 	debugPrintf("Parser:\n");
 	debugPrintf(" suffixes - Lists the vocabulary suffixes\n");
@@ -347,6 +358,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache - Shows resource cache hit and miss statistics\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -365,6 +377,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" set_palette - Sets a palette resource\n");
 	debugPrintf(" draw_pic - Draws a pic resource\n");
 	debugPrintf(" draw_cel - Draws a cel from a view resource\n");
+	debugPrintf(" cel_bench - Times drawing all cels of a view resource offscreen (SCI2+)\n");
 	debugPrintf(" pic_visualize - Enables visualization of the drawing process of EGA pictures\n");
 	debugPrintf(" undither - Enable/disable undithering\n");
 	debugPrintf(" play_video - Plays a SEQ, AVI, VMD, RBT or DUK video\n");
@@ -388,6 +401,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_stats - Shows garbage collection pause times and counts\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -414,6 +428,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" step_event / se - Steps forward until a SCI event is received.\n");
 	debugPrintf(" step_global / sg - Steps until the global variable with the specified index is modified.\n");
 	debugPrintf(" step_callk / snk - Steps forward until it hits the next callk operation, or a specific callk (specified as a parameter)\n");
+	debugPrintf(" vm_bench - Times a number of VM steps from the current state\n");
 	debugPrintf(" disasm - Disassembles a method by name\n");
 	debugPrintf(" disasm_addr - Disassembles one or more commands\n");
 	debugPrintf(" send - Sends a message to an object\n");
@@ -1045,6 +1060,38 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			resMan->resetTypeStats();
+			debugPrintf("Resource cache statistics cleared\n");
+		} else {
+			debugPrintf("Shows hit and miss statistics of the resource cache.\n");
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	debugPrintf("Cached: %d KB of %d KB, locked: %d KB\n",
+		resMan->getMemoryLRU() / 1024, resMan->getMaxMemoryLRU() / 1024, resMan->getMemoryLocked() / 1024);
+	debugPrintf("%-12s %8s %8s %6s %8s %10s %10s %8s\n", "Type", "Hits", "Misses", "Hit%", "Evicted", "KB loaded", "KB evicted", "KB LRU");
+
+	for (int i = 0; i < kResourceTypeInvalid; ++i) {
+		const ResourceManager::TypeStats &stats = resMan->getTypeStats((ResourceType)i);
+		const uint32 lookups = stats.hits + stats.misses;
+		if (!lookups && !stats.memoryLRU)
+			continue;
+
+		debugPrintf("%-12s %8u %8u %5u%% %8u %10u %10u %8d\n", getResourceTypeName((ResourceType)i),
+			stats.hits, stats.misses, lookups ? (uint)((uint64)stats.hits * 100 / lookups) : 0,
+			stats.evictions, stats.bytesLoaded / 1024, stats.bytesEvicted / 1024, stats.memoryLRU / 1024);
+	}
+
+	return true;
+}
+
 bool Console::cmdDissectScript(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Examines a script\n");
@@ -1670,6 +1717,28 @@ bool Console::cmdListSaves(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdAvoidPathStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Shows statistics on the pathfinding done by kAvoidPath.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		resetAvoidPathStats();
+		debugPrintf("Pathfinding statistics reset\n");
+		return true;
+	}
+
+	const AvoidPathStats &stats = getAvoidPathStats();
+	debugPrintf("Calls: %u\n", stats.calls);
+	debugPrintf("Time per call: last %u ms, max %u ms, average %u ms\n", stats.lastTime, stats.maxTime,
+			stats.calls ? stats.totalTime / stats.calls : 0);
+	debugPrintf("Vertices in last call: %u\n", stats.lastVertices);
+	debugPrintf("Visibility graphs: %u reused, %u built\n", stats.graphHits, stats.graphMisses);
+	return true;
+}
+
 bool Console::cmdClassTable(int argc, const char **argv) {
 	debugPrintf("Available classes (parse a parameter to filter the table by a specific class):\n");
 
@@ -1991,6 +2060,67 @@ bool Console::cmdDrawCel(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelBench(int argc, const char **argv) {
+	if (argc < 2) {
+		debugPrintf("Draws all cels of a view resource into an offscreen buffer a number\n");
+		debugPrintf("of times, and shows how many megapixels per second were drawn (SCI2+)\n");
+		debugPrintf("Usage: %s <resourceId> [<iterations>] [mirror]\n", argv[0]);
+		return true;
+	}
+
+#ifdef ENABLE_SCI32
+	if (getSciVersion() < SCI_VERSION_2) {
+		debugPrintf("This SCI version does not support this command\n");
+		return true;
+	}
+
+	const GuiResourceId viewId = atoi(argv[1]);
+	const int iterations = argc > 2 ? MAX(atoi(argv[2]), 1) : 100;
+	const bool mirrorX = argc > 3 && !scumm_stricmp(argv[3], "mirror");
+
+	if (!_engine->getResMan()->testResource(ResourceId(kResourceTypeView, viewId))) {
+		debugPrintf("View resource %d not found\n", viewId);
+		return true;
+	}
+
+	// Construct all cels first, so that loading them is not timed
+	Common::Array<CelObjView> cels;
+	const int16 numLoops = CelObjView::getNumLoops(viewId);
+	for (int16 loopNo = 0; loopNo < numLoops; ++loopNo) {
+		const int16 numCels = CelObjView::getNumCels(viewId, loopNo);
+		for (int16 celNo = 0; celNo < numCels; ++celNo) {
+			cels.push_back(CelObjView(viewId, loopNo, celNo));
+		}
+	}
+
+	Buffer buffer;
+	buffer.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
+
+	uint64 pixels = 0;
+	const uint32 startTime = g_system->getMillis();
+	for (int i = 0; i < iterations; ++i) {
+		for (uint j = 0; j < cels.size(); ++j) {
+			CelObj &cel = cels[j];
+			Common::Rect targetRect(cel._width, cel._height);
+			targetRect.clip(Common::Rect(buffer.w, buffer.h));
+			cel.draw(buffer, targetRect, Common::Point(0, 0), mirrorX);
+			pixels += targetRect.width() * targetRect.height();
+		}
+	}
+	const uint32 elapsed = MAX<uint32>(g_system->getMillis() - startTime, 1);
+
+	buffer.free();
+
+	debugPrintf("Drew %u cels %d times, %u megapixels in %u ms: %u.%02u megapixels per second\n",
+		cels.size(), iterations, (uint32)(pixels / 1000000), elapsed,
+		(uint32)(pixels / 1000 / elapsed), (uint32)(pixels / 10 / elapsed % 100));
+	debugPrintf("Decompressed cels take up %u KB\n", CelObj::getDecompressedSize() / 1024);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdUndither(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Enable/disable undithering.\n");
@@ -2745,6 +2875,29 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Shows garbage collection statistics.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		resetGCStats();
+		debugPrintf("Garbage collection statistics reset\n");
+		return true;
+	}
+
+	const GCStats &stats = getGCStats();
+	debugPrintf("Collections: %u run, %u skipped (nothing allocated)\n", stats.runs, stats.skipped);
+	debugPrintf("Pause: last %u ms, max %u ms, average %u ms\n", stats.lastPause, stats.maxPause,
+			stats.runs ? stats.totalPause / stats.runs : 0);
+	debugPrintf("Last run: %u active references, %u objects freed\n", stats.lastReferences, stats.lastFreed);
+	debugPrintf("Objects freed in total: %u\n", stats.totalFreed);
+	debugPrintf("Allocations since last run: %u\n", _engine->_gamestate->_segMan->getAllocationsSinceGC());
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
@@ -3495,6 +3648,26 @@ bool Console::cmdStepRet(int argc, const char **argv) {
 	return cmdExit(0, 0);
 }
 
+bool Console::cmdVMBench(int argc, const char **argv) {
+	if (argc < 2 || atoi(argv[1]) <= 0) {
+		debugPrintf("Times the given number of VM steps, starting from the current state.\n");
+		debugPrintf("Use restore_game first to always start from the same state. With\n");
+		debugPrintf("'decode' or 'nodecode', executed instructions are kept decoded or\n");
+		debugPrintf("not for this run, instead of following the decode_scripts setting.\n");
+		debugPrintf("Usage: %s <steps> [decode|nodecode]\n", argv[0]);
+		return true;
+	}
+
+	_debugState.benchSteps = _debugState.benchStepsLeft = atoi(argv[1]);
+	_debugState.benchDecodeScripts = _engine->_decodeScripts;
+	if (argc > 2 && !scumm_stricmp(argv[2], "decode"))
+		_engine->_decodeScripts = true;
+	else if (argc > 2 && !scumm_stricmp(argv[2], "nodecode"))
+		_engine->_decodeScripts = false;
+
+	return cmdExit(0, 0);
+}
+
 bool Console::cmdStepGlobal(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Steps until the global variable with the specified index is modified.\n");
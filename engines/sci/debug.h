@@ -84,6 +84,10 @@ struct DebugState {
 	StackPtr old_sp;
 	Common::List<Breakpoint> _breakpoints;   //< List of breakpoints
 	int _activeBreakpointTypes;  //< Bit mask specifying which types of breakpoints are active
+	int benchSteps;				// Number of VM steps timed by the vm_bench command
+	int benchStepsLeft;			// VM steps left to time, 0 when not benchmarking
+	uint32 benchStartTime;
+	bool benchDecodeScripts;	// Value of SciEngine::_decodeScripts to restore after benchmarking
 
 	void updateActiveBreakpointTypes();
 };
@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -179,8 +180,29 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
+static GCStats s_gcStats;
+
+const GCStats &getGCStats() {
+	return s_gcStats;
+}
+
+void resetGCStats() {
+	memset(&s_gcStats, 0, sizeof(s_gcStats));
+}
+
+void run_gc_periodic(EngineState *s) {
+	if (!s->_segMan->getAllocationsSinceGC()) {
+		++s_gcStats.skipped;
+		return;
+	}
+
+	run_gc(s);
+}
+
 void run_gc(EngineState *s) {
 	SegManager *segMan = s->_segMan;
+	const uint32 startTime = g_system->getMillis();
+	uint32 freed = 0;
 
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
@@ -214,6 +236,7 @@ void run_gc(EngineState *s) {
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
+					++freed;
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
@@ -224,8 +247,20 @@ void run_gc(EngineState *s) {
 		}
 	}
 
+	const uint32 references = activeRefs->size();
 	delete activeRefs;
 
+	segMan->resetAllocationsSinceGC();
+
+	const uint32 pause = g_system->getMillis() - startTime;
+	++s_gcStats.runs;
+	s_gcStats.lastPause = pause;
+	s_gcStats.maxPause = MAX(s_gcStats.maxPause, pause);
+	s_gcStats.totalPause += pause;
+	s_gcStats.lastReferences = references;
+	s_gcStats.lastFreed = freed;
+	s_gcStats.totalFreed += freed;
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -55,6 +55,33 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+/**
+ * Runs garbage collection from the periodic check in the VM. The collection
+ * is skipped when no collectable objects have been allocated and no scripts
+ * have been marked as deleted since the last one, as it could not free
+ * anything that the next collection will not free as well.
+ * @param s The state in which we should gc
+ */
+void run_gc_periodic(EngineState *s);
+
+/**
+ * Statistics on the garbage collections run so far. Times are in
+ * milliseconds.
+ */
+struct GCStats {
+	uint32 runs;            ///< collections run
+	uint32 skipped;         ///< periodic collections skipped
+	uint32 lastPause;       ///< duration of the last collection
+	uint32 maxPause;        ///< duration of the longest collection
+	uint32 totalPause;      ///< duration of all collections
+	uint32 lastReferences;  ///< active references found by the last collection
+	uint32 lastFreed;       ///< objects freed by the last collection
+	uint32 totalFreed;      ///< objects freed by all collections
+};
+
+const GCStats &getGCStats();
+void resetGCStats();
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
@@ -738,6 +738,26 @@ reg_t kFileIOIsValidDirectory(EngineState *s, int argc, reg_t *argv);
 
 //@}
 
+/**
+ * Statistics on the pathfinding done by kAvoidPath. Times are in
+ * milliseconds.
+ */
+struct AvoidPathStats {
+	uint32 calls;
+	uint32 graphHits;    ///< calls that reused the visibility graph of an earlier call
+	uint32 graphMisses;  ///< calls that started a new visibility graph
+	uint32 lastTime;
+	uint32 maxTime;
+	uint32 totalTime;
+	uint32 lastVertices; ///< vertices searched by the last call
+};
+
+const AvoidPathStats &getAvoidPathStats();
+void resetAvoidPathStats();
+
+/** Frees the visibility graphs kAvoidPath keeps between calls. */
+void clearAvoidPathCache();
+
 } // End of namespace Sci
 
 #endif // SCI_ENGINE_KERNEL_H
@@ -117,10 +117,14 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Position in the vertex index
+	int index;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		index = -1;
 	}
 };
 
@@ -242,6 +246,62 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+/**
+ * Uniform grid over the bounding box of all vertices. Every polygon edge is
+ * listed in each cell that its bounding box overlaps, so a visibility test
+ * only needs to check the edges in the cells its line passes through.
+ */
+struct EdgeIndex {
+	enum {
+		kCells = 8
+	};
+
+	int originX, originY;
+	int cellWidth, cellHeight;
+	Common::Array<Vertex *> cells[kCells * kCells];
+
+	// Last query each edge was returned for, by vertex index
+	Common::Array<uint32> stamps;
+	uint32 stamp;
+
+	// Edges returned by the last query
+	Common::Array<Vertex *> result;
+
+	// All edges, in vertex index order
+	Common::Array<Vertex *> edges;
+
+	EdgeIndex() : originX(0), originY(0), cellWidth(1), cellHeight(1), stamp(0) {}
+
+	int column(int x) const {
+		return CLIP<int>((x - originX) / cellWidth, 0, kCells - 1);
+	}
+
+	int row(int y) const {
+		return CLIP<int>((y - originY) / cellHeight, 0, kCells - 1);
+	}
+
+	void build(Vertex **vertexIndex, int vertices);
+	const Common::Array<Vertex *> &query(Common::Point a, Common::Point b);
+};
+
+/**
+ * The vertices visible from each vertex of a polygon set. As polygon sets
+ * rarely change between calls, these are kept for the next calls and
+ * filled in as the search reaches the vertices.
+ */
+struct VisibilityGraph {
+	// Vertex count and coordinates of each polygon
+	Common::Array<int16> key;
+
+	Common::Array<bool> computed;
+
+	// Visible vertices in the order visible_vertices() returns them,
+	// by vertex index
+	Common::Array<Common::Array<uint16> > visible;
+
+	uint32 lastUsed;
+};
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -263,6 +323,19 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Single-vertex polygons added for the start and end points, these are
+	// the first vertices in the index
+	int addedPolygons;
+
+	// Set when the start or end point split a polygon edge
+	bool edgeSplit;
+
+	EdgeIndex edgeIndex;
+
+	// Visibility between the vertices of the polygon set, or NULL when
+	// it cannot be shared with other calls
+	VisibilityGraph *visibility;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -270,6 +343,9 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		addedPolygons = 0;
+		edgeSplit = false;
+		visibility = NULL;
 	}
 
 	~PathfindingState() {
@@ -699,6 +775,135 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+void EdgeIndex::build(Vertex **vertexIndex, int vertices) {
+	for (int i = 0; i < kCells * kCells; i++)
+		cells[i].clear();
+
+	edges.clear();
+	stamps.clear();
+	stamps.resize(vertices);
+	stamp = 0;
+
+	if (!vertices)
+		return;
+
+	int minX = vertexIndex[0]->v.x, maxX = minX;
+	int minY = vertexIndex[0]->v.y, maxY = minY;
+
+	for (int i = 1; i < vertices; i++) {
+		const Common::Point &p = vertexIndex[i]->v;
+		minX = MIN<int>(minX, p.x);
+		maxX = MAX<int>(maxX, p.x);
+		minY = MIN<int>(minY, p.y);
+		maxY = MAX<int>(maxY, p.y);
+	}
+
+	originX = minX;
+	originY = minY;
+	cellWidth = (maxX - minX) / kCells + 1;
+	cellHeight = (maxY - minY) / kCells + 1;
+
+	for (int i = 0; i < vertices; i++) {
+		Vertex *edge = vertexIndex[i];
+		if (!VERTEX_HAS_EDGES(edge))
+			continue;
+
+		edges.push_back(edge);
+
+		const Common::Point &p = edge->v;
+		const Common::Point &q = CLIST_NEXT(edge)->v;
+		const int lastColumn = column(MAX(p.x, q.x));
+		const int lastRow = row(MAX(p.y, q.y));
+
+		for (int y = row(MIN(p.y, q.y)); y <= lastRow; y++)
+			for (int x = column(MIN(p.x, q.x)); x <= lastColumn; x++)
+				cells[y * kCells + x].push_back(edge);
+	}
+}
+
+const Common::Array<Vertex *> &EdgeIndex::query(Common::Point a, Common::Point b) {
+	// between() takes every point on the same row or column as being on a
+	// line of length zero, so such lines have to be checked against all
+	// edges
+	if (a == b)
+		return edges;
+
+	result.clear();
+	++stamp;
+
+	if (a.y > b.y)
+		SWAP(a, b);
+
+	const int lastRow = row(b.y);
+	const float slope = (a.y != b.y) ? (float)(b.x - a.x) / (b.y - a.y) : 0;
+
+	for (int y = row(a.y); y <= lastRow; y++) {
+		int minX = MIN(a.x, b.x);
+		int maxX = MAX(a.x, b.x);
+
+		if (a.y != b.y) {
+			// Where the line enters and leaves this row, widened by a
+			// pixel against rounding errors
+			const int top = MAX<int>(a.y, originY + y * cellHeight);
+			const int bottom = MIN<int>(b.y, originY + (y + 1) * cellHeight);
+			const int x1 = (int)(a.x + (top - a.y) * slope);
+			const int x2 = (int)(a.x + (bottom - a.y) * slope);
+
+			minX = MAX(minX, MIN(x1, x2) - 1);
+			maxX = MIN(maxX, MAX(x1, x2) + 1);
+		}
+
+		const int lastColumn = column(maxX);
+		for (int x = column(minX); x <= lastColumn; x++) {
+			const Common::Array<Vertex *> &cell = cells[y * kCells + x];
+			for (uint i = 0; i < cell.size(); i++) {
+				Vertex *edge = cell[i];
+				if (stamps[edge->index] != stamp) {
+					stamps[edge->index] = stamp;
+					result.push_back(edge);
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Determines whether or not a vertex is visible from another vertex
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to look at
+ * @return true if the line between both vertices does not cross any polygon
+ */
+static bool is_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges. Only edges sharing a cell of the
+	// index with the line can touch it.
+	const Common::Array<Vertex *> &edges = s->edgeIndex.query(vertex_cur->v, vertex->v);
+
+	for (uint j = 0; j < edges.size(); j++) {
+		Vertex *edge = edges[j];
+
+		if (between(vertex_cur->v, vertex->v, edge->v)) {
+			// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+			if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+				return false;
+
+			// This edge won't properly intersect, so we continue
+			continue;
+		}
+
+		if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+			return false;
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -707,34 +912,38 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	VisibilityGraph *graph = s->visibility;
+	const int first = s->addedPolygons;
+
+	// The list is in reverse vertex index order. The start and end points
+	// come first in the index, so they go last here.
+	if (graph && vertex_cur->index >= first) {
+		const int cur = vertex_cur->index - first;
+		Common::Array<uint16> &visible = graph->visible[cur];
+
+		if (!graph->computed[cur]) {
+			for (int i = s->vertices - 1; i >= first; i--) {
+				if (is_visible(s, vertex_cur, s->vertex_index[i]))
+					visible.push_back(i - first);
+			}
+			graph->computed[cur] = true;
+		}
 
-	for (int i = 0; i < s->vertices; i++) {
-		Vertex *vertex = s->vertex_index[i];
+		for (uint i = 0; i < visible.size(); i++)
+			visVerts->push_back(s->vertex_index[visible[i] + first]);
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
+		for (int i = first - 1; i >= 0; i--) {
+			if (is_visible(s, vertex_cur, s->vertex_index[i]))
+				visVerts->push_back(s->vertex_index[i]);
+		}
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+		return visVerts;
+	}
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
-		}
+	for (int i = 0; i < s->vertices; i++) {
+		Vertex *vertex = s->vertex_index[i];
 
-		if (j == s->vertices)
+		if (is_visible(s, vertex_cur, vertex))
 			visVerts->push_front(vertex);
 	}
 
@@ -1129,6 +1338,7 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 				if (between(vertex->v, next->v, v)) {
 					// Split edge by adding vertex
 					polygon->vertices.insertAfter(vertex, v_new);
+					s->edgeSplit = true;
 					return v_new;
 				}
 			}
@@ -1139,10 +1349,95 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 	polygon = new Polygon(POLY_BARRED_ACCESS);
 	polygon->vertices.insertHead(v_new);
 	s->polygons.push_front(polygon);
+	s->addedPolygons++;
 
 	return v_new;
 }
 
+enum {
+	kVisibilityCacheSize = 2
+};
+
+static VisibilityGraph *s_visibilityCache[kVisibilityCacheSize];
+static uint32 s_visibilityCacheClock = 0;
+static AvoidPathStats s_avoidPathStats;
+
+const AvoidPathStats &getAvoidPathStats() {
+	return s_avoidPathStats;
+}
+
+void resetAvoidPathStats() {
+	memset(&s_avoidPathStats, 0, sizeof(s_avoidPathStats));
+}
+
+void clearAvoidPathCache() {
+	for (int i = 0; i < kVisibilityCacheSize; i++) {
+		delete s_visibilityCache[i];
+		s_visibilityCache[i] = NULL;
+	}
+}
+
+/**
+ * Finds the cached visibility graph for the polygons of the pathfinding
+ * state, leaving out the single-vertex polygons of the start and end
+ * points. When there is none, the least recently used graph is replaced
+ * by an empty one.
+ * Parameters: (PathfindingState *) s: The pathfinding state
+ * Returns   : (VisibilityGraph *) The visibility graph
+ */
+static VisibilityGraph *find_visibility_graph(PathfindingState *s) {
+	Common::Array<int16> key;
+	PolygonList::iterator it = s->polygons.begin();
+
+	for (int i = 0; i < s->addedPolygons; i++)
+		++it;
+
+	for (; it != s->polygons.end(); ++it) {
+		Vertex *vertex;
+
+		key.push_back((*it)->vertices.size());
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			key.push_back(vertex->v.x);
+			key.push_back(vertex->v.y);
+		}
+	}
+
+	int slot = 0;
+
+	for (int i = 0; i < kVisibilityCacheSize; i++) {
+		VisibilityGraph *graph = s_visibilityCache[i];
+
+		if (graph && graph->key == key) {
+			graph->lastUsed = ++s_visibilityCacheClock;
+			s_avoidPathStats.graphHits++;
+			return graph;
+		}
+	}
+
+	for (int i = 0; i < kVisibilityCacheSize; i++) {
+		if (!s_visibilityCache[i]) {
+			slot = i;
+			break;
+		}
+
+		if (s_visibilityCache[i]->lastUsed < s_visibilityCache[slot]->lastUsed)
+			slot = i;
+	}
+
+	delete s_visibilityCache[slot];
+
+	VisibilityGraph *graph = new VisibilityGraph();
+	const int vertices = s->vertices - s->addedPolygons;
+	graph->key = key;
+	graph->computed.resize(vertices);
+	graph->visible.resize(vertices);
+	graph->lastUsed = ++s_visibilityCacheClock;
+
+	s_visibilityCache[slot] = graph;
+	s_avoidPathStats.graphMisses++;
+	return graph;
+}
+
 /**
  * Converts an SCI polygon into a Polygon
  * Parameters: (EngineState *) s: The game state
@@ -1339,12 +1634,20 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->index = count;
 			pf_s->vertex_index[count++] = vertex;
 		}
 	}
 
 	pf_s->vertices = count;
 
+	pf_s->edgeIndex.build(pf_s->vertex_index, count);
+
+	// Visibility between the polygon vertices does not depend on the start
+	// and end points, unless they split an edge
+	if (!pf_s->edgeSplit)
+		pf_s->visibility = find_visibility_graph(pf_s);
+
 	return pf_s;
 }
 
@@ -1542,6 +1845,18 @@ static reg_t output_path(PathfindingState *p, EngineState *s) {
 	return output;
 }
 
+static void record_pathfinding_time(uint32 startTime, int vertices) {
+	const uint32 time = g_system->getMillis() - startTime;
+
+	s_avoidPathStats.calls++;
+	s_avoidPathStats.lastTime = time;
+	s_avoidPathStats.maxTime = MAX(s_avoidPathStats.maxTime, time);
+	s_avoidPathStats.totalTime += time;
+	s_avoidPathStats.lastVertices = vertices;
+
+	debugC(kDebugLevelAvoidPath, "[avoidpath] Pathfinding took %d ms for %d vertices", time, vertices);
+}
+
 reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 	Common::Point start = Common::Point(argv[0].toSint16(), argv[1].toSint16());
 
@@ -1609,6 +1924,7 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 			}
 		}
 
+		const uint32 startTime = g_system->getMillis();
 		PathfindingState *p = convert_polygon_set(s, poly_list, start, end, width, height, opt);
 
 		if (!p) {
@@ -1623,6 +1939,7 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 			writePoint(arrayRef, 1, end);
 			writePoint(arrayRef, 2, Common::Point(POLY_LAST_POINT, POLY_LAST_POINT));
 
+			record_pathfinding_time(startTime, 0);
 			return output;
 		}
 
@@ -1630,6 +1947,7 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 		AStar(p);
 
 		output = output_path(p, s);
+		record_pathfinding_time(startTime, p->vertices);
 		delete p;
 
 		// Memory is freed by explicit calls to Memory
@@ -34,6 +34,7 @@
 #include "common/str.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "graphics/dirtyrects.h"
 #include "graphics/palette.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
@@ -50,7 +51,35 @@
 
 namespace Sci {
 
+/**
+ * Pixel doubles one area of a video frame into the same area of a buffer
+ * twice its size, like GfxScreen::scale2x() does for the whole frame.
+ */
+static void scale2xRect(const Graphics::Surface &frame, byte *dst, uint16 dstPitch, const Common::Rect &rect) {
+	const byte bytesPerPixel = frame.format.bytesPerPixel;
+	const uint rowSize = rect.width() * 2 * bytesPerPixel;
+
+	for (int16 y = rect.top; y < rect.bottom; ++y) {
+		const byte *in = (const byte *)frame.getBasePtr(rect.left, y);
+		byte *row = dst + y * 2 * dstPitch + rect.left * 2 * bytesPerPixel;
+		byte *out = row;
+
+		for (int16 x = rect.left; x < rect.right; ++x) {
+			memcpy(out, in, bytesPerPixel);
+			memcpy(out + bytesPerPixel, in, bytesPerPixel);
+			in += bytesPerPixel;
+			out += bytesPerPixel * 2;
+		}
+
+		memcpy(row + dstPitch, row, rowSize);
+	}
+}
+
 void playVideo(Video::VideoDecoder &videoDecoder) {
+	// Catch up by dropping frames on machines too slow to decode them all
+	videoDecoder.setFrameDropThreshold(100);
+	// Only the areas that changed are copied to the screen below
+	videoDecoder.setTrackDirtyRegion(true);
 	videoDecoder.start();
 
 	Common::SpanOwner<SciSpan<byte> > scaleBuffer;
@@ -84,8 +113,26 @@ void playVideo(Video::VideoDecoder &videoDecoder) {
 		if (videoDecoder.needsUpdate()) {
 			const Graphics::Surface *frame = videoDecoder.decodeNextFrame();
 
+			// Decoders that know which areas changed since the last frame let
+			// us leave the rest of the screen alone
+			const Graphics::DirtyRectList *dirtyRegion = videoDecoder.getDirtyRegion();
+
 			if (frame) {
-				if (scaleBuffer) {
+				if (dirtyRegion && !dirtyRegion->isAllDirty()) {
+					const Common::Array<Common::Rect> &rects = dirtyRegion->getRects();
+
+					for (uint i = 0; i < rects.size(); ++i) {
+						const Common::Rect &r = rects[i];
+
+						if (scaleBuffer) {
+							byte *scaled = scaleBuffer->getUnsafeDataAt(0, pitch * height);
+							scale2xRect(*frame, scaled, pitch, r);
+							g_system->copyRectToScreen(scaled + r.top * 2 * pitch + r.left * 2 * bytesPerPixel, pitch, x + r.left * 2, y + r.top * 2, r.width() * 2, r.height() * 2);
+						} else {
+							g_system->copyRectToScreen(frame->getBasePtr(r.left, r.top), frame->pitch, x + r.left, y + r.top, r.width(), r.height());
+						}
+					}
+				} else if (scaleBuffer) {
 					const SciSpan<const byte> input((const byte *)frame->getPixels(), frame->w * frame->h * bytesPerPixel);
 					// TODO: Probably should do aspect ratio correction in KQ6
 					g_sci->_gfxScreen->scale2x(input, *scaleBuffer, videoDecoder.getWidth(), videoDecoder.getHeight(), bytesPerPixel);
@@ -113,6 +160,8 @@ void playVideo(Video::VideoDecoder &videoDecoder) {
 
 		g_system->delayMillis(10);
 	}
+
+	debugC(kDebugLevelVideo, "Video done, %d frames dropped", videoDecoder.getDroppedFrameCount());
 }
 
 reg_t kShowMovie(EngineState *s, int argc, reg_t *argv) {
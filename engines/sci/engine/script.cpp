@@ -53,6 +53,8 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_buf.clear();
 	_script.clear();
 	_heap.clear();
+	_decodedIndex.clear();
+	_decoded.clear();
 	_exports.clear();
 	_numExports = 0;
 	_synonyms.clear();
@@ -90,6 +92,33 @@ enum {
 	kSci11ExportTableOffset = 8
 };
 
+const Script::DecodedInstruction *Script::getDecodedInstruction(uint32 offset) {
+	// Only code is executed, which starts at _codeOffset and ends with the
+	// script resource, before the heap and locals of SCI1.1+ scripts
+	if (offset < (uint32)_codeOffset || offset >= _script.size())
+		return NULL;
+
+	if (_decodedIndex.empty())
+		_decodedIndex.resize(_script.size() - _codeOffset);
+
+	const uint16 index = _decodedIndex[offset - _codeOffset];
+	if (index)
+		return &_decoded[index - 1];
+
+	if (_decoded.size() == 0xFFFF)
+		return NULL;
+
+	DecodedInstruction instruction;
+	int16 opparams[4] = { 0, 0, 0, 0 };
+	instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, opparams);
+	for (int i = 0; i < ARRAYSIZE(instruction.params); ++i)
+		instruction.params[i] = opparams[i];
+
+	_decoded.push_back(instruction);
+	_decodedIndex[offset - _codeOffset] = _decoded.size();
+	return &_decoded.back();
+}
+
 void Script::load(int script_nr, ResourceManager *resMan, ScriptPatcher *scriptPatcher, bool applyScriptPatches) {
 	freeScript();
 
@@ -125,6 +125,25 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+public:
+	/**
+	 * A VM instruction with its operands already read, as returned by
+	 * readPMachineInstruction().
+	 */
+	struct DecodedInstruction {
+		int16 params[3];
+		byte size;       ///< Length of the instruction in bytes
+		byte extOpcode;
+	};
+
+private:
+	// Instructions decoded so far, so each one only has to be decoded the
+	// first time it is executed. _decodedIndex holds, for every offset into
+	// the code, starting at _codeOffset, the index into _decoded plus one,
+	// or 0 if no instruction at that offset has been decoded yet.
+	Common::Array<uint16> _decodedIndex;
+	Common::Array<DecodedInstruction> _decoded;
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -157,6 +176,16 @@ public:
 	inline bool offsetIsObject(uint32 offset) const {
 		return _buf->getUint16SEAt(offset + SCRIPT_OBJECT_MAGIC_OFFSET) == SCRIPT_OBJECT_MAGIC_NUMBER;
 	}
+
+	/**
+	 * Returns the instruction at the given offset, decoding it if this is the
+	 * first time it is asked for. The returned pointer is only valid until
+	 * the next call.
+	 * @return the instruction, or NULL if the offset lies outside of the
+	 *         code or too many instructions have been decoded already, and
+	 *         the caller needs to decode it itself
+	 */
+	const DecodedInstruction *getDecodedInstruction(uint32 offset);
 public:
 	Script();
 	~Script() override;
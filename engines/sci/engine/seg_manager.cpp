@@ -40,6 +40,9 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_nodesSegId = 0;
 	_hunksSegId = 0;
 
+	// Nonzero, so the first periodic collection is never skipped
+	_allocationsSinceGC = 1;
+
 	_saveDirPtr = NULL_REG;
 	_parserPtr = NULL_REG;
 
@@ -72,6 +75,9 @@ void SegManager::resetSegMan() {
 	_nodesSegId = 0;
 	_hunksSegId = 0;
 
+	// Nonzero, so the first periodic collection is never skipped
+	_allocationsSinceGC = 1;
+
 #ifdef ENABLE_SCI32
 	_arraysSegId = 0;
 	_bitmapSegId = 0;
@@ -413,6 +419,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	table = (HunkTable *)_heap[_hunksSegId];
 
 	offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	reg_t addr = make_reg(_hunksSegId, offset);
 	Hunk *h = &table->at(offset);
@@ -448,6 +455,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 		table = (CloneTable *)_heap[_clonesSegId];
 
 	offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -462,6 +470,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	table = (ListTable *)_heap[_listsSegId];
 
 	offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_listsSegId, offset);
 	return &table->at(offset);
@@ -476,6 +485,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	table = (NodeTable *)_heap[_nodesSegId];
 
 	offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_nodesSegId, offset);
 	return &table->at(offset);
@@ -861,6 +871,7 @@ byte *SegManager::allocDynmem(int size, const char *descr, reg_t *addr) {
 	SegmentId seg;
 	SegmentObj *mobj = allocSegment(new DynMem(), &seg);
 	*addr = make_reg(seg, 0);
+	++_allocationsSinceGC;
 
 	DynMem &d = *(DynMem *)mobj;
 
@@ -903,6 +914,7 @@ SciArray *SegManager::allocateArray(SciArrayType type, uint16 size, reg_t *addr)
 		table = (ArrayTable *)_heap[_arraysSegId];
 
 	offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_arraysSegId, offset);
 
@@ -959,6 +971,7 @@ SciBitmap *SegManager::allocateBitmap(reg_t *addr, const int16 width, const int1
 	}
 
 	offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_bitmapSegId, offset);
 	SciBitmap &bitmap = table->at(offset);
@@ -1090,6 +1103,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		++_allocationsSinceGC;
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
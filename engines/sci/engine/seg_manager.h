@@ -459,6 +459,13 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * Return the number of collectable objects allocated, and scripts
+	 * marked as deleted, since the last garbage collection.
+	 */
+	uint32 getAllocationsSinceGC() const { return _allocationsSinceGC; }
+	void resetAllocationsSinceGC() { _allocationsSinceGC = 0; }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -473,6 +480,8 @@ private:
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
 	SegmentId _hunksSegId; ///< ID of the (a) hunk segment
 
+	uint32 _allocationsSinceGC; ///< see getAllocationsSinceGC()
+
 	// Statically allocated memory for system strings
 	reg_t _saveDirPtr;
 	reg_t _parserPtr;
@@ -23,6 +23,7 @@
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/system.h"
 
 #include "sci/sci.h"
 #include "sci/console.h"
@@ -579,6 +580,26 @@ uint32 findOffset(const int16 relOffset, const Script *scr, const uint32 pcOffse
 	return offset;
 }
 
+/**
+ * Counts one VM step for the vm_bench console command, and reports the time
+ * taken once all requested steps have run.
+ */
+static void benchmarkStep(DebugState &debugState) {
+	if (debugState.benchStepsLeft == debugState.benchSteps)
+		debugState.benchStartTime = g_system->getMillis();
+
+	if (--debugState.benchStepsLeft)
+		return;
+
+	const uint32 elapsed = MAX<uint32>(g_system->getMillis() - debugState.benchStartTime, 1);
+	Console *con = g_sci->getSciDebugger();
+	con->debugPrintf("%d VM steps %s took %u ms, %u steps per second\n", debugState.benchSteps,
+		g_sci->_decodeScripts ? "using decoded scripts" : "decoding every instruction",
+		elapsed, (uint32)((uint64)debugState.benchSteps * 1000 / elapsed));
+	g_sci->_decodeScripts = debugState.benchDecodeScripts;
+	con->attach();
+}
+
 void run_vm(EngineState *s) {
 	assert(s);
 
@@ -682,11 +703,26 @@ void run_vm(EngineState *s) {
 		}
 #endif
 
+		if (g_sci->_debugState.benchStepsLeft)
+			benchmarkStep(g_sci->_debugState);
+
 		// Get opcode
 		byte extOpcode;
-		if (!vmHooks.isActive(s))
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
-		else {
+		if (!vmHooks.isActive(s)) {
+			const Script::DecodedInstruction *instruction = NULL;
+			if (g_sci->_decodeScripts)
+				instruction = scr->getDecodedInstruction(s->xs->addr.pc.getOffset());
+
+			if (instruction) {
+				extOpcode = instruction->extOpcode;
+				opparams[0] = instruction->params[0];
+				opparams[1] = instruction->params[1];
+				opparams[2] = instruction->params[2];
+				s->xs->addr.pc.incOffset(instruction->size);
+			} else {
+				s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+			}
+		} else {
 			int offset = readPMachineInstruction(vmHooks.data(), extOpcode, opparams);
 			vmHooks.advance(offset);
 		}
@@ -929,7 +965,7 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_gc_periodic(s);
 			}
 
 			// Call kernel function
@@ -92,6 +92,11 @@ void CelObj::init() {
 	_nextCacheId = 1;
 	_scaler.reset(new CelScaler());
 	_cache.reset(new CelCache(100));
+
+	// Decompressed copies of hot compressed cels, in KB, off by default
+	_decompressedBudget = 0;
+	if (ConfMan.hasKey("cel_cache"))
+		_decompressedBudget = MAX(ConfMan.getInt("cel_cache"), 0) * 1024;
 }
 
 void CelObj::deinit() {
@@ -147,6 +152,15 @@ struct SCALER_NoScale {
 			return *_row++;
 		}
 	}
+
+	/**
+	 * Returns the source pixels from the current position on, for reading a
+	 * whole span at once. Only valid when not flipped.
+	 */
+	inline const byte *getPixels() const {
+		assert(!FLIP);
+		return _row;
+	}
 };
 
 template<bool FLIP, typename READER>
@@ -350,6 +364,8 @@ public:
 struct READER_Compressed {
 private:
 	const SciSpan<const byte> _resource;
+	const byte *_pixels;
+	const int16 _sourceWidth;
 	byte _buffer[kCelScalerTableSize];
 	uint32 _controlOffset;
 	uint32 _dataOffset;
@@ -360,8 +376,10 @@ private:
 	const int16 _maxWidth;
 
 public:
-	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
+	READER_Compressed(const CelObj &celObj, const int16 maxWidth, const bool useDecompressed = true) :
 	_resource(celObj.getResPointer()),
+	_pixels(useDecompressed ? celObj.getDecompressedPixels() : nullptr),
+	_sourceWidth(celObj._width),
 	_y(-1),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
@@ -376,6 +394,10 @@ public:
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
+		if (_pixels) {
+			return _pixels + y * _sourceWidth;
+		}
+
 		if (y != _y) {
 			// compressed data segment for row
 			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
@@ -433,6 +455,52 @@ public:
 	}
 };
 
+#pragma mark -
+#pragma mark CelObj - Decompressed cels
+
+enum {
+	/**
+	 * The number of times a compressed cel needs to be drawn before a
+	 * decompressed copy of it is kept.
+	 */
+	kDecompressAfterDraws = 3
+};
+
+uint32 CelObj::_decompressedSize = 0;
+uint32 CelObj::_decompressedBudget = 0;
+
+CelObj::DecompressedCel::~DecompressedCel() {
+	delete[] pixels;
+	_decompressedSize -= size;
+}
+
+const byte *CelObj::getDecompressedPixels() const {
+	DecompressedCel *decompressed = _decompressed.get();
+	if (!decompressed) {
+		return nullptr;
+	}
+
+	if (decompressed->pixels || ++decompressed->drawCount < kDecompressAfterDraws) {
+		return decompressed->pixels;
+	}
+
+	const uint32 size = _width * _height;
+	if (_decompressedSize + size > _decompressedBudget) {
+		return nullptr;
+	}
+
+	byte *pixels = new byte[size];
+	READER_Compressed reader(*this, _width, false);
+	for (int16 y = 0; y < _height; ++y) {
+		memcpy(pixels + y * _width, reader.getRow(y), _width);
+	}
+
+	decompressed->pixels = pixels;
+	decompressed->size = size;
+	_decompressedSize += size;
+	return pixels;
+}
+
 #pragma mark -
 #pragma mark CelObj - Remappers
 
@@ -695,11 +763,15 @@ int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) co
 	return -1;
 }
 
-void CelObj::putCopyInCache(const int cacheIndex) const {
+void CelObj::putCopyInCache(const int cacheIndex) {
 	if (cacheIndex == -1) {
 		error("Invalid cache index");
 	}
 
+	if (_compressionType != kCelCompressionNone && _decompressedBudget) {
+		_decompressed = Common::SharedPtr<DecompressedCel>(new DecompressedCel());
+	}
+
 	CelCacheEntry &entry = (*_cache)[cacheIndex];
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
@@ -743,6 +815,93 @@ struct RENDERER {
 	}
 };
 
+/**
+ * Copies a row of pixels, leaving out those of the skip color. Four pixels
+ * are checked at a time, so fully opaque and fully transparent runs only
+ * cost one comparison per four pixels.
+ */
+static inline void copyRowSkip(byte *target, const byte *source, int16 width, const uint8 skipColor) {
+	const uint32 skipColors = skipColor * 0x01010101;
+
+	for (; width >= 4; width -= 4, source += 4, target += 4) {
+		const uint32 pixels = READ_UINT32(source);
+		const uint32 diff = pixels ^ skipColors;
+
+		if (diff == 0) {
+			// All four pixels are transparent
+			continue;
+		}
+
+		if (((diff - 0x01010101) & ~diff & 0x80808080) == 0) {
+			// No byte of diff is zero, so all four pixels are opaque
+			WRITE_UINT32(target, pixels);
+			continue;
+		}
+
+		for (int i = 0; i < 4; ++i) {
+			if (source[i] != skipColor) {
+				target[i] = source[i];
+			}
+		}
+	}
+
+	for (; width > 0; --width, ++source, ++target) {
+		if (*source != skipColor) {
+			*target = *source;
+		}
+	}
+}
+
+/**
+ * Renderer for unscaled, unmirrored cels without transparency or remapping,
+ * which copies whole rows at once.
+ */
+template<typename READER>
+struct RENDERER<MAPPER_NoMDNoSkip, SCALER_NoScale<false, READER>, false> {
+	SCALER_NoScale<false, READER> &_scaler;
+
+	RENDERER(MAPPER_NoMDNoSkip &, SCALER_NoScale<false, READER> &scaler, const uint8) :
+	_scaler(scaler) {}
+
+	inline void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &) const {
+		byte *targetPixel = (byte *)target.getPixels() + target.w * targetRect.top + targetRect.left;
+
+		const int16 targetWidth = targetRect.width();
+		const int16 targetHeight = targetRect.height();
+		for (int16 y = 0; y < targetHeight; ++y) {
+			_scaler.setTarget(targetRect.left, targetRect.top + y);
+			memcpy(targetPixel, _scaler.getPixels(), targetWidth);
+			targetPixel += target.w;
+		}
+	}
+};
+
+/**
+ * Renderer for unscaled, unmirrored cels with transparency and without
+ * remapping, which copies whole rows at once using copyRowSkip.
+ */
+template<typename READER>
+struct RENDERER<MAPPER_NoMD, SCALER_NoScale<false, READER>, false> {
+	SCALER_NoScale<false, READER> &_scaler;
+	const uint8 _skipColor;
+
+	RENDERER(MAPPER_NoMD &, SCALER_NoScale<false, READER> &scaler, const uint8 skipColor) :
+	_scaler(scaler),
+	_skipColor(skipColor) {}
+
+	inline void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &) const {
+		byte *targetPixel = (byte *)target.getPixels() + target.w * targetRect.top + targetRect.left;
+
+		const int16 targetWidth = targetRect.width();
+		const int16 targetHeight = targetRect.height();
+		for (int16 y = 0; y < targetHeight; ++y) {
+			_scaler.setTarget(targetRect.left, targetRect.top + y);
+			copyRowSkip(targetPixel, _scaler.getPixels(), targetWidth, _skipColor);
+			targetPixel += target.w;
+		}
+	}
+};
+
 template<typename MAPPER, typename SCALER>
 void CelObj::render(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
 
@@ -23,6 +23,7 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource.h"
@@ -408,6 +409,18 @@ public:
 	 */
 	void submitPalette() const;
 
+	/**
+	 * Retrieves the decompressed pixels of a compressed cel, if it has been
+	 * drawn often enough to keep a decompressed copy of it within the
+	 * `cel_cache` budget. Returns null otherwise.
+	 */
+	const byte *getDecompressedPixels() const;
+
+	/**
+	 * Returns the total size of all decompressed cel copies, in bytes.
+	 */
+	static uint32 getDecompressedSize() { return _decompressedSize; }
+
 #pragma mark -
 #pragma mark CelObj - Drawing
 private:
@@ -459,6 +472,33 @@ protected:
 	 */
 	static Common::ScopedPtr<CelCache> _cache;
 
+	/**
+	 * A decompressed copy of the pixels of a compressed cel. It is shared by
+	 * all copies of the cel object, including the one in the cel cache, so
+	 * the pixels only need to be decompressed once.
+	 */
+	struct DecompressedCel {
+		byte *pixels;
+		uint32 size;
+		int drawCount;
+
+		DecompressedCel() : pixels(nullptr), size(0), drawCount(0) {}
+		~DecompressedCel();
+	};
+
+	/**
+	 * The decompressed copy of this cel. Only set for compressed cels when
+	 * the `cel_cache` budget is not zero.
+	 */
+	Common::SharedPtr<DecompressedCel> _decompressed;
+
+	/**
+	 * The total size of all decompressed cel copies, and the maximum size
+	 * they may take up, in bytes.
+	 */
+	static uint32 _decompressedSize;
+	static uint32 _decompressedBudget;
+
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
 	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
@@ -468,9 +508,11 @@ protected:
 	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
 
 	/**
-	 * Puts a copy of this CelObj into the cache at the given cache index.
+	 * Puts a copy of this CelObj into the cache at the given cache index. A
+	 * compressed cel also gets a slot for a decompressed copy shared with the
+	 * cached one.
 	 */
-	void putCopyInCache(int index) const;
+	void putCopyInCache(int index);
 };
 
 #pragma mark -
@@ -22,6 +22,7 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
@@ -212,6 +213,8 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
+	_lruPrev = nullptr;
+	_lruNext = nullptr;
 }
 
 Resource::~Resource() {
@@ -980,7 +983,9 @@ void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
-	_LRU.clear();
+	_lruHead = nullptr;
+	_lruTail = nullptr;
+	memset(_typeStats, 0, sizeof(_typeStats));
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1064,6 +1069,14 @@ void ResourceManager::init() {
 	}
 #endif
 
+	// Allow the budget to be tuned per game, e.g. lowered on machines with
+	// little memory or raised to avoid reloading resources on slow media
+	if (!_detectionMode && ConfMan.hasKey("resource_cache")) {
+		const int cacheSize = ConfMan.getInt("resource_cache");
+		if (cacheSize > 0)
+			_maxMemoryLRU = cacheSize * 1024;
+	}
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1110,8 +1123,19 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+
+	if (res->_lruPrev)
+		res->_lruPrev->_lruNext = res->_lruNext;
+	else
+		_lruHead = res->_lruNext;
+	if (res->_lruNext)
+		res->_lruNext->_lruPrev = res->_lruPrev;
+	else
+		_lruTail = res->_lruPrev;
+	res->_lruPrev = res->_lruNext = nullptr;
+
 	_memoryLRU -= res->size();
+	_typeStats[res->getType()].memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
 }
 
@@ -1120,8 +1144,17 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
+
+	res->_lruPrev = nullptr;
+	res->_lruNext = _lruHead;
+	if (_lruHead)
+		_lruHead->_lruPrev = res;
+	else
+		_lruTail = res;
+	_lruHead = res;
+
 	_memoryLRU += res->size();
+	_typeStats[res->getType()].memoryLRU += res->size();
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
 	      res->_id.toString().c_str(), res->size,
@@ -1133,24 +1166,67 @@ void ResourceManager::addToLRU(Resource *res) {
 void ResourceManager::printLRU() {
 	int mem = 0;
 	int entries = 0;
-	Common::List<Resource *>::iterator it = _LRU.begin();
-	Resource *res;
 
-	while (it != _LRU.end()) {
-		res = *it;
+	for (Resource *res = _lruHead; res; res = res->_lruNext) {
 		debug("\t%s: %u bytes", res->_id.toString().c_str(), res->size());
 		mem += res->size();
 		++entries;
-		++it;
 	}
 
 	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
 }
 
+/**
+ * Returns how much it costs to free a resource of the given type and load it
+ * again later, from 0 (cheap) to 2 (expensive).
+ */
+static int getReloadPriority(ResourceType type) {
+	switch (type) {
+	case kResourceTypeScript:
+	case kResourceTypeHeap:
+	case kResourceTypeVocab:
+	case kResourceTypeFont:
+	case kResourceTypeCursor:
+	case kResourceTypePalette:
+	case kResourceTypeMessage:
+	case kResourceTypePatch:
+		// Small and needed over and over again
+		return 2;
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypeBitmap:
+		// Usually compressed, reloading means decompressing them again
+		return 1;
+	default:
+		// Audio, sync and video data are large and mostly played only once
+		return 0;
+	}
+}
+
 void ResourceManager::freeOldResources() {
+	// Number of least recently used resources to choose the next one to free
+	// from. Small enough to keep freeing cheap and to not hold on to stale
+	// resources of an expensive type forever.
+	const int kEvictionWindow = 4;
+
 	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+		assert(_lruTail);
+		Resource *goner = _lruTail;
+		int gonerPriority = getReloadPriority(goner->getType());
+
+		Resource *res = goner->_lruPrev;
+		for (int i = 1; i < kEvictionWindow && res && gonerPriority > 0; ++i, res = res->_lruPrev) {
+			const int priority = getReloadPriority(res->getType());
+			if (priority < gonerPriority) {
+				goner = res;
+				gonerPriority = priority;
+			}
+		}
+
+		TypeStats &stats = _typeStats[goner->getType()];
+		stats.evictions++;
+		stats.bytesEvicted += goner->size();
+
 		removeFromLRU(goner);
 		goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
@@ -1159,6 +1235,15 @@ void ResourceManager::freeOldResources() {
 	}
 }
 
+void ResourceManager::resetTypeStats() {
+	for (int i = 0; i < kResourceTypeInvalid; ++i) {
+		// The memory under LRU control is not a statistic, so keep it
+		const int memoryLRU = _typeStats[i].memoryLRU;
+		memset(&_typeStats[i], 0, sizeof(TypeStats));
+		_typeStats[i].memoryLRU = memoryLRU;
+	}
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1195,9 +1280,16 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	TypeStats &stats = _typeStats[retval->getType()];
+	if (retval->_status == kResStatusNoMalloc) {
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+		stats.misses++;
+		stats.bytesLoaded += retval->size();
+	} else {
+		stats.hits++;
+	}
+
+	if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
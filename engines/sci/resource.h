@@ -305,6 +305,11 @@ protected:
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
+	// Neighbours in the LRU list of the resource manager, most recently used
+	// towards _lruPrev. Only valid while _status is kResStatusEnqueued.
+	Resource *_lruPrev;
+	Resource *_lruNext;
+
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
 	bool loadFromWaveFile(Common::SeekableReadStream *file);
@@ -478,6 +483,25 @@ public:
 	 */
 	ResourceType convertResType(byte type);
 
+	/**
+	 * Cache statistics of one resource type, for the debugger.
+	 */
+	struct TypeStats {
+		uint32 hits;         ///< Lookups which found the resource still in memory
+		uint32 misses;       ///< Lookups which had to load the resource
+		uint32 evictions;    ///< Resources freed to stay within the memory budget
+		uint32 bytesLoaded;
+		uint32 bytesEvicted;
+		int memoryLRU;       ///< Bytes of this type currently under LRU control
+	};
+
+	const TypeStats &getTypeStats(ResourceType type) const { return _typeStats[type]; }
+	void resetTypeStats();
+
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMaxMemoryLRU() const { return _maxMemoryLRU; }
+	int getMemoryLocked() const { return _memoryLocked; }
+
 protected:
 	bool _detectionMode;
 
@@ -492,7 +516,9 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Resource *_lruHead;	///< Most recently used resource under LRU control
+	Resource *_lruTail;	///< Least recently used resource under LRU control
+	TypeStats _typeStats[kResourceTypeInvalid];
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -553,6 +579,12 @@ protected:
 	Common::SeekableReadStream *getVolumeFile(ResourceSource *source);
 	void disposeVolumeFileStream(Common::SeekableReadStream *fileStream, ResourceSource *source);
 	void loadResource(Resource *res);
+
+	/**
+	 * Frees unlocked resources until the LRU memory is within _maxMemoryLRU.
+	 * Among the least recently used few, resources which are cheap to load
+	 * again go first, see getReloadPriority().
+	 */
 	void freeOldResources();
 	bool validateResource(const ResourceId &resourceId, const Common::String &sourceMapLocation, const Common::String &sourceName, const uint32 offset, const uint32 size, const uint32 sourceSize) const;
 	Resource *addResource(ResourceId resId, ResourceSource *src, uint32 offset, uint32 size = 0, const Common::String &sourceMapLocation = Common::String("(no map location)"));
@@ -110,6 +110,7 @@ SciEngine::SciEngine(OSystem *syst, const ADGameDescription *desc, SciGameId gam
 	_opcode_formats = 0;
 
 	_forceHiresGraphics = false;
+	_decodeScripts = false;
 
 	InitSciReadWriteFunctions();
 
@@ -207,6 +208,8 @@ SciEngine::~SciEngine() {
 	// Remove all of our debug levels here
 	DebugMan.clearAllDebugChannels();
 
+	clearAvoidPathCache();
+
 #ifdef ENABLE_SCI32
 	delete _gfxControls32;
 	delete _gfxPaint32;
@@ -303,6 +306,11 @@ Common::Error SciEngine::run() {
 		_forceHiresGraphics = ConfMan.getBool("enable_high_resolution_graphics");
 	}
 
+	// Decoded scripts trade memory for speed, so machines with little
+	// memory have to ask for them
+	if (ConfMan.hasKey("decode_scripts"))
+		_decodeScripts = ConfMan.getBool("decode_scripts");
+
 	if (getSciVersion() <= SCI_VERSION_1_1) {
 		// Initialize the game screen
 		_gfxScreen = new GfxScreen(_resMan);
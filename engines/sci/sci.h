@@ -385,6 +385,10 @@ public:
 
 	DebugState _debugState;
 
+	// Keep executed script instructions decoded, see
+	// Script::getDecodedInstruction(). Off unless enabled by "decode_scripts".
+	bool _decodeScripts;
+
 	Common::MacResManager *getMacExecutable() { return &_macExecutable; }
 
 private:
@@ -37,6 +37,8 @@
 
 namespace Scumm {
 
+extern const char *nameOfResType(ResType type);
+
 #if defined(__amigaos3__) && defined(NDEBUG)
 inline void debugC(int channel, const char *s, ...) {}
 #else
@@ -84,6 +86,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	registerCmd("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
 	registerCmd("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
+	registerCmd("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
 
 	if (_vm->_game.id == GID_LOOM)
 		registerCmd("drafts",  WRAP_METHOD(ScummDebugger, Cmd_PrintDraft));
@@ -844,6 +847,47 @@ bool ScummDebugger::Cmd_Passcode(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			_vm->_res->resetStats();
+			debugPrintf("Resource statistics cleared\n");
+		} else {
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	debugPrintf("+-----------+-----+--------+-------+--------+-------+------+-------+--------+-------+--------+\n");
+	debugPrintf("|Type       |Held |KB held |Loads  |KB read |Hits   |Hit %% |Evicted|KB freed|Reloads|KB again|\n");
+	debugPrintf("+-----------+-----+--------+-------+--------+-------+------+-------+--------+-------+--------+\n");
+
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		const ResourceManager::ResTypeData &data = _vm->_res->_types[type];
+		if (data._mode == kDynamicResTypeMode)
+			continue;
+
+		uint held = 0;
+		uint32 heldSize = 0;
+		for (uint idx = 0; idx < data.size(); ++idx) {
+			if (data[idx]._address) {
+				held++;
+				heldSize += data[idx]._size;
+			}
+		}
+
+		const ResourceManager::ResTypeStats &stats = data._stats;
+		const uint32 lookups = stats.hits + stats.loads;
+		debugPrintf("|%-11s|%5d|%8d|%7d|%8d|%7d|%5d%%|%7d|%8d|%7d|%8d|\n",
+			nameOfResType(type), held, heldSize / 1024, stats.loads, stats.bytesLoaded / 1024, stats.hits,
+			lookups ? (int)((uint64)stats.hits * 100 / lookups) : 0,
+			stats.evictions, stats.bytesEvicted / 1024, stats.reloads, stats.bytesReloaded / 1024);
+	}
+
+	debugPrintf("+-----------+-----+--------+-------+--------+-------+------+-------+--------+-------+--------+\n");
+	return true;
+}
+
 bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	_vm->resetCursors();
 	detach();
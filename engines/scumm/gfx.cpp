@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/config-manager.h"
 #include "common/system.h"
 #include "scumm/actor.h"
 #include "scumm/charset.h"
@@ -272,9 +273,12 @@ void Gdi::init() {
 		// the backbuf (thus we have to treat the right border seperately).
 		_numStrips += 1;
 	}
+
+	_stripCache.setBudget(ConfMan.hasKey("strip_cache") ? ConfMan.getInt("strip_cache") * 1024 : 0);
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	_stripCache.clear();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -1018,7 +1022,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbCacheStrips);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1782,6 +1786,120 @@ int Gdi::getZPlanes(const byte *ptr, const byte *zplane_list[9], bool bmapImage)
 	return numzbuf;
 }
 
+StripCache::StripCache() : _budget(0), _used(0), _clock(0), _image(nullptr), _y(0), _height(0), _numZBuffers(0) {
+	memset(_roomPalette, 0, sizeof(_roomPalette));
+}
+
+StripCache::~StripCache() {
+	clear();
+}
+
+void StripCache::setBudget(uint32 bytes) {
+	clear();
+	_budget = bytes;
+}
+
+void StripCache::validate(const byte *image, int y, int height, int numZBuffers, const byte *roomPalette) {
+	if (image == _image && y == _y && height == _height && numZBuffers == _numZBuffers &&
+		!memcmp(roomPalette, _roomPalette, sizeof(_roomPalette)))
+		return;
+
+	clear();
+	_image = image;
+	_y = y;
+	_height = height;
+	_numZBuffers = numZBuffers;
+	memcpy(_roomPalette, roomPalette, sizeof(_roomPalette));
+}
+
+const byte *StripCache::find(int stripnr) {
+	if (stripnr < 0 || stripnr >= (int)_entries.size() || !_entries[stripnr].data)
+		return nullptr;
+
+	_entries[stripnr].lastUse = ++_clock;
+	return _entries[stripnr].data;
+}
+
+byte *StripCache::insert(int stripnr) {
+	const uint32 size = getEntrySize();
+	if (stripnr < 0 || size > _budget)
+		return nullptr;
+
+	if (stripnr >= (int)_entries.size())
+		_entries.resize(stripnr + 1);
+
+	Entry &entry = _entries[stripnr];
+	if (!entry.data) {
+		while (_used + size > _budget)
+			evictOldest();
+
+		entry.data = (byte *)malloc(size);
+		if (!entry.data)
+			return nullptr;
+		_used += size;
+	}
+
+	entry.lastUse = ++_clock;
+	return entry.data;
+}
+
+void StripCache::clear() {
+	for (uint i = 0; i < _entries.size(); ++i)
+		free(_entries[i].data);
+	_entries.clear();
+	_used = 0;
+	_image = nullptr;
+}
+
+void StripCache::evictOldest() {
+	int oldest = -1;
+	for (uint i = 0; i < _entries.size(); ++i) {
+		if (_entries[i].data && (oldest < 0 || _entries[i].lastUse < _entries[oldest].lastUse))
+			oldest = i;
+	}
+
+	assert(oldest >= 0);
+	free(_entries[oldest].data);
+	_entries[oldest].data = nullptr;
+	_used -= getEntrySize();
+}
+
+void Gdi::drawCachedStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int height,
+						int numzbuf, const byte *zplane_list[9], const byte *cached) {
+	for (int h = 0; h < height; ++h) {
+		memcpy(dstPtr, cached, 8);
+		dstPtr += vs->pitch;
+		cached += 8;
+	}
+
+	for (int i = 1; i < numzbuf; ++i, cached += height) {
+		if (!zplane_list[i])
+			continue;
+
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; ++h)
+			mask_ptr[h * _numStrips] = cached[h];
+	}
+}
+
+void Gdi::cacheStrip(byte *entry, const byte *dstPtr, VirtScreen *vs, int x, int y, const int height,
+					int numzbuf, const byte *zplane_list[9]) {
+	for (int h = 0; h < height; ++h) {
+		memcpy(entry, dstPtr, 8);
+		dstPtr += vs->pitch;
+		entry += 8;
+	}
+
+	for (int i = 1; i < numzbuf; ++i, entry += height) {
+		if (!zplane_list[i])
+			continue;
+
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; ++h)
+			entry[h] = mask_ptr[h * _numStrips];
+	}
+}
+
 /**
  * Draw a bitmap onto a virtual screen. This is main drawing method for room backgrounds
  * and objects, used throughout all SCUMM versions.
@@ -1826,6 +1944,13 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	// Only the plain 8-bit strip decoders of V4-V7 are known to produce
+	// the same result every time, regardless of what was drawn before.
+	const bool useCache = (flag & dbCacheStrips) && _stripCache.isEnabled() && vs->format.bytesPerPixel == 1 &&
+		_vm->_game.version >= 4 && _vm->_game.version <= 7 && _vm->_game.heversion == 0;
+	if (useCache)
+		_stripCache.validate(ptr, y, height, numzbuf, _vm->_roomPalette);
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1858,12 +1983,19 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const byte *cached = useCache ? _stripCache.find(stripnr) : nullptr;
+		if (cached)
+			transpStrip = false;
+		else
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
 			transpStrip = true;
 
+		if (cached)
+			drawCachedStrip(dstPtr, vs, x, y, height, numzbuf, zplane_list, cached);
+
 		if (vs->hasTwoBuffers) {
 			byte *frontBuf = (byte *)vs->getBasePtr(x * 8, y);
 			if (lightsOn)
@@ -1872,7 +2004,16 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (!cached) {
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+			// Transparent strips depend on what was below them.
+			if (useCache && !transpStrip) {
+				byte *entry = _stripCache.insert(stripnr);
+				if (entry)
+					cacheStrip(entry, dstPtr, vs, x, y, height, numzbuf, zplane_list);
+			}
+		}
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
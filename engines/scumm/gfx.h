@@ -24,6 +24,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -194,6 +195,64 @@ struct StripTable;
 #define CHARSET_MASK_TRANSPARENCY	 0xFD
 #define CHARSET_MASK_TRANSPARENCY_32 0xFDFDFDFD
 
+/**
+ * Keeps decoded 8 pixel wide strips of the room background together with
+ * their z-plane masks, so redrawing or scrolling the room copies them back
+ * instead of decompressing the strips again. The room image never changes
+ * while the room is shown, so the cache only has to be dropped when the
+ * room, the strip height, the z-planes or the room palette change.
+ *
+ * The cache is bounded by a memory budget, set with the "strip_cache"
+ * config key in KB; the strips drawn least recently are dropped first.
+ */
+class StripCache {
+public:
+	StripCache();
+	~StripCache();
+
+	/** Set the memory budget in bytes, 0 disables the cache. */
+	void setBudget(uint32 bytes);
+	bool isEnabled() const { return _budget != 0; }
+
+	/**
+	 * Drop all strips unless they were decoded from the same image with the
+	 * same vertical extent, number of z-planes and room palette.
+	 */
+	void validate(const byte *image, int y, int height, int numZBuffers, const byte *roomPalette);
+
+	/**
+	 * Return the 8 * height pixels of a strip followed by height mask bytes
+	 * for every z-plane above 0, or nullptr if the strip is not cached.
+	 */
+	const byte *find(int stripnr);
+
+	/**
+	 * Return a buffer to store a decoded strip in, laid out as for find(),
+	 * or nullptr if it does not fit the budget.
+	 */
+	byte *insert(int stripnr);
+
+	void clear();
+
+private:
+	struct Entry {
+		byte *data;
+		uint32 lastUse;
+	};
+
+	uint32 getEntrySize() const { return _height * (8 + (_numZBuffers > 1 ? _numZBuffers - 1 : 0)); }
+	void evictOldest();
+
+	Common::Array<Entry> _entries;
+	uint32 _budget;
+	uint32 _used;
+	uint32 _clock;
+
+	const byte *_image;
+	int _y, _height, _numZBuffers;
+	byte _roomPalette[256];
+};
+
 class Gdi {
 protected:
 	ScummEngine *_vm;
@@ -209,6 +268,8 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	StripCache _stripCache;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -256,6 +317,11 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
 
+	void drawCachedStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int height,
+					int numzbuf, const byte *zplane_list[9], const byte *cached);
+	void cacheStrip(byte *entry, const byte *dstPtr, VirtScreen *vs, int x, int y, const int height,
+					int numzbuf, const byte *zplane_list[9]);
+
 public:
 	Gdi(ScummEngine *vm);
 	virtual ~Gdi();
@@ -282,7 +348,8 @@ public:
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbCacheStrips   = 1 << 4
 	};
 };
 
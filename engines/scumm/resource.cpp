@@ -47,10 +47,20 @@ enum {
 	RF_USAGE = 0x7F,
 	RF_USAGE_MAX = RF_USAGE,
 
+	RS_RELOADED = 0x08,
 	RS_MODIFIED = 0x10,
+	RS_EXPIRED = 0x20,
 	RF_OFFHEAP = 0x40
 };
 
+enum {
+	// Approximate cost, in bytes read, of finding a resource in the data
+	// files before any of its contents can be read.
+	kReloadOverhead = 4096,
+	// Resources at least this large all weigh the same for expiry.
+	kExpirySizeLimit = 1024 * 1024
+};
+
 
 
 extern const char *nameOfResType(ResType type);
@@ -745,8 +755,11 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 		return NULL;
 
 	// If the resource is missing, but loadable from the game data files, try to do so.
-	if (!_res->_types[type][idx]._address && _res->_types[type]._mode != kDynamicResTypeMode) {
-		ensureResourceLoaded(type, idx);
+	if (_res->_types[type]._mode != kDynamicResTypeMode) {
+		if (!_res->_types[type][idx]._address)
+			ensureResourceLoaded(type, idx);
+		else
+			_res->countHit(type);
 	}
 
 	ptr = (byte *)_res->_types[type][idx]._address;
@@ -843,6 +856,18 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
 	setResourceCounter(type, idx, 1);
+
+	if (_types[type]._mode != kDynamicResTypeMode) {
+		Resource &res = _types[type][idx];
+		ResTypeStats &stats = _types[type]._stats;
+		stats.loads++;
+		stats.bytesLoaded += size;
+		if (res._status & RS_EXPIRED) {
+			stats.reloads++;
+			stats.bytesReloaded += size;
+			res._status = (res._status & ~RS_EXPIRED) | RS_RELOADED;
+		}
+	}
 	return ptr;
 }
 
@@ -871,6 +896,7 @@ void ResourceManager::Resource::nuke() {
 ResourceManager::ResTypeData::ResTypeData() {
 	_mode = kDynamicResTypeMode;
 	_tag = 0;
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 ResourceManager::ResTypeData::~ResTypeData() {
@@ -1041,8 +1067,28 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+uint32 ResourceManager::expiryScore(ResType type, const Resource &res) const {
+	// Reading a resource back costs a seek plus its size. For small ones the
+	// seek dominates, so throwing them out frees little memory for the work.
+	uint32 score = res.getResourceCounter();
+	if (res._size >= kExpirySizeLimit)
+		score <<= 8;
+	else
+		score *= (res._size << 8) / (res._size + kReloadOverhead);
+
+	// Scripts, costumes and charsets are small and used over and over.
+	if (type == rtScript || type == rtCostume || type == rtCharset)
+		score >>= 1;
+
+	// Thrown out before and needed again soon after.
+	if (res._status & RS_RELOADED)
+		score >>= 1;
+
+	return score;
+}
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
+	uint32 best_score, best_size;
 	ResType best_type;
 	int best_res = 0;
 	uint32 oldAllocatedSize;
@@ -1059,7 +1105,8 @@ void ResourceManager::expireResources(uint32 size) {
 
 	do {
 		best_type = rtInvalid;
-		best_counter = 2;
+		best_score = 0;
+		best_size = 0;
 
 		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
 			if (_types[type]._mode != kDynamicResTypeMode) {
@@ -1068,9 +1115,17 @@ void ResourceManager::expireResources(uint32 size) {
 				ResId idx = _types[type].size();
 				while (idx-- > 0) {
 					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
+					if (tmp.isLocked() || tmp.getResourceCounter() < 2 || !tmp._address || tmp.isOffHeap())
+						continue;
+
+					// Prefer the highest score, and the larger one among equals.
+					uint32 score = expiryScore(type, tmp);
+					if (best_type != rtInvalid && (score < best_score || (score == best_score && tmp._size <= best_size)))
+						continue;
+
+					if (!_vm->isResourceInUse(type, idx)) {
+						best_score = score;
+						best_size = tmp._size;
 						best_type = type;
 						best_res = idx;
 					}
@@ -1080,6 +1135,11 @@ void ResourceManager::expireResources(uint32 size) {
 
 		if (!best_type)
 			break;
+
+		Resource &victim = _types[best_type][best_res];
+		_types[best_type]._stats.evictions++;
+		_types[best_type]._stats.bytesEvicted += victim._size;
+		victim._status |= RS_EXPIRED;
 		nukeResource(best_type, best_res);
 	} while (size + _allocatedSize > _minHeapThreshold);
 
@@ -1145,6 +1205,11 @@ void ResourceManager::resourceStats() {
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
 }
 
+void ResourceManager::resetStats() {
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1))
+		memset(&_types[type]._stats, 0, sizeof(_types[type]._stats));
+}
+
 void ScummEngine_v5::readMAXS(int blockSize) {
 	_numVariables = _fileHandle->readUint16LE();      // 800
 	_fileHandle->readUint16LE();                      // 16
@@ -81,6 +81,7 @@ protected:
 
 public:
 	class Resource {
+	friend class ResourceManager;
 	public:
 		/**
 		 * Pointer to the data contained in this resource
@@ -105,8 +106,9 @@ public:
 		byte _flags;
 
 		/**
-		 * The status of the resource. Currently only one bit is used, which
-		 * indicates whether the resource is modified.
+		 * The status of the resource. One bit indicates whether the resource
+		 * is modified (HE), the others are kept across nuke() so that a
+		 * resource reloaded after being expired can be recognized.
 		 */
 		byte _status;
 
@@ -147,6 +149,20 @@ public:
 		bool isOffHeap() const;
 	};
 
+	/**
+	 * Usage statistics of one resource type, for the debugger. Only
+	 * resources which can be loaded from the game data files are counted.
+	 */
+	struct ResTypeStats {
+		uint32 loads;         ///< Number of times a resource was read from the data files
+		uint32 hits;          ///< Number of lookups finding the resource already loaded
+		uint32 evictions;     ///< Number of resources thrown out by expireResources()
+		uint32 reloads;       ///< Number of loads of a resource which was evicted before
+		uint32 bytesLoaded;   ///< Bytes read by those loads
+		uint32 bytesEvicted;  ///< Bytes freed by those evictions
+		uint32 bytesReloaded; ///< Bytes read by those reloads
+	};
+
 	/**
 	 * This struct represents a resource type and all resource of that type.
 	 */
@@ -165,6 +181,8 @@ public:
 		 */
 		uint32 _tag;
 
+		ResTypeStats _stats;
+
 	public:
 		ResTypeData();
 		~ResTypeData();
@@ -225,10 +243,27 @@ public:
 
 	void resourceStats();
 
+	/**
+	 * Clear the usage statistics of all resource types.
+	 */
+	void resetStats();
+
+	/**
+	 * Count a lookup of an already loaded resource.
+	 */
+	void countHit(ResType type) { _types[type]._stats.hits++; }
+
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+
+	/**
+	 * Return how worthwhile it is to expire the given resource: high for
+	 * old and large resources, low for small scripts, costumes and charsets
+	 * which are cheap to keep but cost a file access each time they come back.
+	 */
+	uint32 expiryScore(ResType type, const Resource &res) const;
 };
 
 } // End of namespace Scumm
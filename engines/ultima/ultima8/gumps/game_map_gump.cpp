@@ -91,11 +91,16 @@ void GameMapGump::GetCameraLocation(int32 &lx, int32 &ly, int32 &lz,
 }
 
 void GameMapGump::PaintThis(RenderSurface *surf, int32 lerp_factor, bool scaled) {
+	if (BuildDisplayList(surf, lerp_factor))
+		_displayList->PaintDisplayList(_highlightItems);
+}
+
+bool GameMapGump::BuildDisplayList(RenderSurface *surf, int32 lerp_factor) {
 	World *world = World::get_instance();
-	if (!world) return; // Is it possible the world doesn't exist?
+	if (!world) return false; // Is it possible the world doesn't exist?
 
 	CurrentMap *map = world->getCurrentMap();
-	if (!map) return;   // Is it possible the map doesn't exist?
+	if (!map) return false;   // Is it possible the map doesn't exist?
 
 
 	// Get the camera location
@@ -181,8 +186,43 @@ void GameMapGump::PaintThis(RenderSurface *surf, int32 lerp_factor, bool scaled)
 		                      _draggingFlags, Item::EXT_TRANSPARENT);
 	}
 
+	return true;
+}
+
+uint32 GameMapGump::BenchmarkSorting(int count, bool reuse, uint32 &items, uint32 &comparisons) {
+	RenderSurface *surf = Ultima8Engine::get_instance()->getRenderScreen();
+	items = comparisons = 0;
+
+	// Set up the origin and clipping rect like Paint() does, as the
+	// sorting grid is built from the clipping rect
+	int32 ox = 0, oy = 0;
+	surf->GetOrigin(ox, oy);
+	int32 nx = 0, ny = 0;
+	GumpToParent(nx, ny);
+	surf->SetOrigin(ox + nx, oy + ny);
+
+	Rect old_rect;
+	surf->GetClippingRect(old_rect);
+	Rect new_rect = _dims;
+	new_rect.Intersect(old_rect);
+	surf->SetClippingRect(new_rect);
+
+	_displayList->SetReuseEnabled(reuse);
+	uint32 start = g_system->getMillis();
+	for (int i = 0; i < count; i++) {
+		if (!BuildDisplayList(surf, 256))
+			break;
+		_displayList->SortDisplayList();
+		items = _displayList->GetItemCount();
+		comparisons += _displayList->GetComparisons();
+	}
+	uint32 elapsed = g_system->getMillis() - start;
+	_displayList->SetReuseEnabled(true);
+
+	surf->SetClippingRect(old_rect);
+	surf->SetOrigin(ox, oy);
 
-	_displayList->PaintDisplayList(_highlightItems);
+	return elapsed;
 }
 
 // Trace a click, and return ObjId
@@ -49,6 +49,13 @@ public:
 
 	void        PaintThis(RenderSurface *surf, int32 lerp_factor, bool scaled) override;
 
+	// Fill the display list with the items in view. Returns false if there is no map.
+	bool        BuildDisplayList(RenderSurface *surf, int32 lerp_factor);
+
+	// Build and sort the display list of the current view count times, without
+	// painting. Returns the milliseconds taken.
+	uint32      BenchmarkSorting(int count, bool reuse, uint32 &items, uint32 &comparisons);
+
 	void                GetCameraLocation(int32 &x, int32 &y, int32 &z,
 	                                      int lerp_factor = 256);
 
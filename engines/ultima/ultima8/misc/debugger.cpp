@@ -118,10 +118,13 @@ Debugger::Debugger() : Shared::Debugger() {
 	registerCmd("Cheat::items", WRAP_METHOD(Debugger, cmdCheatItems));
 	registerCmd("Cheat::equip", WRAP_METHOD(Debugger, cmdCheatEquip));
 
+	registerCmd("CurrentMap::queryStats", WRAP_METHOD(Debugger, cmdQueryStats));
+
 	registerCmd("GameMapGump::toggleHighlightItems", WRAP_METHOD(Debugger, cmdToggleHighlightItems));
 	registerCmd("GameMapGump::dumpMap", WRAP_METHOD(Debugger, cmdDumpMap));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::benchmarkSorting", WRAP_METHOD(Debugger, cmdBenchmarkSorting));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
@@ -716,6 +719,22 @@ bool Debugger::cmdToggleInvincibility(int argc, const char **argv) {
 }
 
 
+bool Debugger::cmdQueryStats(int argc, const char **argv) {
+	CurrentMap *map = World::get_instance()->getCurrentMap();
+	uint32 queries = map->getQueryCount();
+	uint32 tested = map->getItemsTested();
+	uint32 checked = map->getItemsChecked();
+
+	debugPrintf("%u collision and search queries since last call\n", queries);
+	if (queries) {
+		debugPrintf("%u items tested, %u per query\n", tested, tested / queries);
+		debugPrintf("%u items checked in detail, %u per query\n", checked, checked / queries);
+	}
+
+	map->resetQueryStats();
+	return true;
+}
+
 bool Debugger::cmdToggleHighlightItems(int argc, const char **argv) {
 	GameMapGump::Set_highlightItems(!GameMapGump::is_highlightItems());
 	return false;
@@ -889,6 +908,35 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdBenchmarkSorting(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("usage: GameMapGump::benchmarkSorting [<frames>]\n");
+		return true;
+	}
+
+	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (!gump) {
+		debugPrintf("No game map\n");
+		return true;
+	}
+
+	int frames = (argc == 2) ? static_cast<int>(strtol(argv[1], 0, 0)) : 100;
+	if (frames <= 0)
+		frames = 1;
+
+	// Sorting the current view again and again, once building the list
+	// every time, and once keeping it while nothing changes
+	uint32 items, comparisons, reusedItems, reusedComparisons;
+	uint32 built = gump->BenchmarkSorting(frames, false, items, comparisons);
+	uint32 reused = gump->BenchmarkSorting(frames, true, reusedItems, reusedComparisons);
+
+	debugPrintf("%u items, %u overlap checks per frame instead of %u\n",
+	            items, comparisons / frames, items * (items - 1) / 2);
+	debugPrintf("Building: %u ms for %d frames\n", built, frames);
+	debugPrintf("Reusing: %u ms for %d frames\n", reused, frames);
+	return true;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
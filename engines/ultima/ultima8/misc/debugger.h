@@ -190,11 +190,15 @@ private:
 	bool cmdHeal(int argc, const char **argv);
 	bool cmdToggleInvincibility(int argc, const char **argv);
 
+	// Current Map
+	bool cmdQueryStats(int argc, const char **argv);
+
 	// Game Map Gump
 	bool cmdToggleHighlightItems(int argc, const char **argv);
 	bool cmdDumpMap(int argc, const char **argvv);
 	bool cmdIncrementSortOrder(int argc, const char **argv);
 	bool cmdDecrementSortOrder(int argc, const char **argv);
+	bool cmdBenchmarkSorting(int argc, const char **argv);
 
 	// Kernel
 	bool cmdProcessTypes(int argc, const char **argv);
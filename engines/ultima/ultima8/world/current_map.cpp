@@ -50,7 +50,8 @@ typedef Std::list<Item *> item_list;
 static const int INT_MAX_VALUE = 0x7fffffff;
 
 CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
-	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1) {
+	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1),
+	  _queryCount(0), _itemsTested(0), _itemsChecked(0) {
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
 		Std::memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
@@ -76,6 +77,7 @@ void CurrentMap::clear() {
 			for (iter = _items[i][j].begin(); iter != _items[i][j].end(); ++iter)
 				delete *iter;
 			_items[i][j].clear();
+			_index[i][j].clear();
 		}
 		Std::memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
@@ -144,6 +146,7 @@ void CurrentMap::writeback() {
 				}
 			}
 			_items[i][j].clear();
+			_index[i][j].clear();
 		}
 	}
 
@@ -235,6 +238,7 @@ void CurrentMap::addItem(Item *item) {
 	int32 cy = iy / _mapChunkSize;
 
 	_items[cx][cy].push_front(item);
+	_index[cx][cy].insert(0, item);
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -261,6 +265,7 @@ void CurrentMap::addItemToEnd(Item *item) {
 	int32 cy = iy / _mapChunkSize;
 
 	_items[cx][cy].push_back(item);
+	_index[cx][cy].insert(_index[cx][cy]._item.size(), item);
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -297,6 +302,77 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 
 	_items[cx][cy].remove(item);
 	item->clearExtFlag(Item::EXT_INCURMAP);
+
+	int pos = _index[cx][cy].find(item);
+	if (pos >= 0)
+		_index[cx][cy].remove(pos);
+}
+
+void CurrentMap::updateItem(Item *item) {
+	int32 ix, iy, iz;
+
+	item->getLocation(ix, iy, iz);
+
+	if (ix < 0 || ix >= _mapChunkSize * MAP_NUM_CHUNKS ||
+	        iy < 0 || iy >= _mapChunkSize * MAP_NUM_CHUNKS)
+		return;
+
+	ChunkIndex &index = _index[ix / _mapChunkSize][iy / _mapChunkSize];
+	int pos = index.find(item);
+	if (pos >= 0)
+		index.set(pos, item);
+}
+
+void CurrentMap::ChunkIndex::insert(uint pos, Item *item) {
+	_item.insert_at(pos, item);
+	_x.insert_at(pos, 0);
+	_y.insert_at(pos, 0);
+	_z.insert_at(pos, 0);
+	_xyd.insert_at(pos, 0);
+	_zd.insert_at(pos, 0);
+	_shapeFlags.insert_at(pos, 0);
+	set(pos, item);
+}
+
+void CurrentMap::ChunkIndex::set(uint pos, const Item *item) {
+	int32 ix, iy, iz, ixd, iyd, izd;
+	item->getLocation(ix, iy, iz);
+	item->getFootpadWorld(ixd, iyd, izd);
+
+	_x[pos] = ix;
+	_y[pos] = iy;
+	_z[pos] = iz;
+	_xyd[pos] = MAX(ixd, iyd);
+	_zd[pos] = izd;
+	_shapeFlags[pos] = item->getShapeInfo()->_flags;
+}
+
+void CurrentMap::ChunkIndex::remove(uint pos) {
+	_item.remove_at(pos);
+	_x.remove_at(pos);
+	_y.remove_at(pos);
+	_z.remove_at(pos);
+	_xyd.remove_at(pos);
+	_zd.remove_at(pos);
+	_shapeFlags.remove_at(pos);
+}
+
+int CurrentMap::ChunkIndex::find(const Item *item) const {
+	for (uint i = 0; i < _item.size(); ++i) {
+		if (_item[i] == item)
+			return i;
+	}
+	return -1;
+}
+
+void CurrentMap::ChunkIndex::clear() {
+	_item.clear();
+	_x.clear();
+	_y.clear();
+	_z.clear();
+	_xyd.clear();
+	_zd.clear();
+	_shapeFlags.clear();
 }
 
 // Check to see if the chunk is on the screen
@@ -450,13 +526,20 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 	int maxy = ((y + range) / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	++_queryCount;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
+			const ChunkIndex &index = _index[cx][cy];
+			const uint count = index._item.size();
+			_itemsTested += count;
+			for (uint i = 0; i < count; ++i) {
+				if (!index.touches(i, x - xd - range - 1, y - yd - range - 1, -INT_MAX_VALUE,
+				                   x + range + 1, y + range + 1, INT_MAX_VALUE))
+					continue;
 
-				const Item *item = *iter;
+				const Item *item = index._item[i];
+				++_itemsChecked;
 
 				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
@@ -519,13 +602,20 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 	int maxy = ((origin[1]) / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	++_queryCount;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
+			const ChunkIndex &index = _index[cx][cy];
+			const uint count = index._item.size();
+			_itemsTested += count;
+			for (uint i = 0; i < count; ++i) {
+				if (!index.touches(i, origin[0] - dims[0] - 1, origin[1] - dims[1] - 1, origin[2] - 1,
+				                   origin[0] + 1, origin[1] + 1, origin[2] + dims[2] + 1))
+					continue;
 
-				const Item *item = *iter;
+				const Item *item = index._item[i];
+				++_itemsChecked;
 
 				if (item->getObjId() == check)
 					continue;
@@ -649,12 +739,23 @@ bool CurrentMap::isValidPosition(int32 x, int32 y, int32 z,
 	int maxy = (y / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	++_queryCount;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-				 iter != _items[cx][cy].end(); ++iter) {
-				const Item *item = *iter;
+			const ChunkIndex &index = _index[cx][cy];
+			const uint count = index._item.size();
+			_itemsTested += count;
+			for (uint i = 0; i < count; ++i) {
+				if (!(index._shapeFlags[i] & flagmask))
+					continue;
+				if (!index.touches(i, x - xd - 1, y - yd - 1, -INT_MAX_VALUE,
+				                   x + 1, y + 1, INT_MAX_VALUE))
+					continue;
+
+				const Item *item = index._item[i];
+				++_itemsChecked;
+
 				if (item->getObjId() == item_)
 					continue;
 				if (item->hasExtFlags(Item::EXT_SPRITE))
@@ -761,12 +862,25 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 	int maxy = (y / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	++_queryCount;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *citem = *iter;
+			const ChunkIndex &index = _index[cx][cy];
+			const uint count = index._item.size();
+			_itemsTested += count;
+			for (uint n = 0; n < count; ++n) {
+				if (!(index._shapeFlags[n] & blockflagmask))
+					continue;
+				// Items further away than the 8 units scanned in each
+				// direction don't change the masks
+				if (!index.touches(n, x - xd - 16, y - yd - 16, z - 16,
+				                   x + 16, y + 16, z + zd + 16))
+					continue;
+
+				const Item *citem = index._item[n];
+				++_itemsChecked;
+
 				if (citem->getObjId() == item->getObjId())
 					continue;
 				if (citem->hasExtFlags(Item::EXT_SPRITE))
@@ -932,15 +1046,39 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 //	pout << "Sweeping to   (" << vel[0]-ext[0] << ", " << vel[1]-ext[1] << ", " << vel[2]-ext[2] << ")" << Std::endl;
 //	pout << "              (" << vel[0]+ext[0] << ", " << vel[1]+ext[1] << ", " << vel[2]+ext[2] << ")" << Std::endl;
 
+	// The box swept by the item. Anything not touching it can't be hit,
+	// the margin covers the rounding of the hit times.
+	const int32 sweepmin[3] = {
+		MIN(start[0], end[0]) - dims[0] - 4,
+		MIN(start[1], end[1]) - dims[1] - 4,
+		MIN(start[2], end[2]) - 4
+	};
+	const int32 sweepmax[3] = {
+		MAX(start[0], end[0]) + 4,
+		MAX(start[1], end[1]) + 4,
+		MAX(start[2], end[2]) + dims[2] + 4
+	};
+
 	Std::list<SweepItem>::iterator sw_it;
 	if (hit) sw_it = hit->end();
 
+	++_queryCount;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *other_item = *iter;
+			const ChunkIndex &index = _index[cx][cy];
+			const uint count = index._item.size();
+			_itemsTested += count;
+			for (uint n = 0; n < count; ++n) {
+				if (blocking_only && !(index._shapeFlags[n] & shapeflags & blockflagmask))
+					continue;
+				if (!index.touches(n, sweepmin[0], sweepmin[1], sweepmin[2],
+				                   sweepmax[0], sweepmax[1], sweepmax[2]))
+					continue;
+
+				const Item *other_item = index._item[n];
+				++_itemsChecked;
+
 				if (other_item->getObjId() == item)
 					continue;
 				if (other_item->hasExtFlags(Item::EXT_SPRITE))
@@ -1125,12 +1263,22 @@ const Item *CurrentMap::traceTopItem(int32 x, int32 y, int32 ztop, int32 zbot, O
 	int maxy = (y / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	++_queryCount;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *item = *iter;
+			const ChunkIndex &index = _index[cx][cy];
+			const uint count = index._item.size();
+			_itemsTested += count;
+			for (uint i = 0; i < count; ++i) {
+				if (!(index._shapeFlags[i] & shflags))
+					continue;
+				if (!index.touches(i, x - 1, y - 1, zbot - 1, x + 1, y + 1, ztop + 1))
+					continue;
+
+				const Item *item = index._item[i];
+				++_itemsChecked;
+
 				if (item->getObjId() == ignore)
 					continue;
 				if (item->hasExtFlags(Item::EXT_SPRITE))
@@ -1165,6 +1313,12 @@ const Item *CurrentMap::traceTopItem(int32 x, int32 y, int32 ztop, int32 zbot, O
 	return top;
 }
 
+void CurrentMap::resetQueryStats() {
+	_queryCount = 0;
+	_itemsTested = 0;
+	_itemsChecked = 0;
+}
+
 void CurrentMap::setWholeMapFast() {
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; ++i) {
 		for (unsigned int j = 0; j < MAP_NUM_CHUNKS; ++j) {
@@ -69,6 +69,10 @@ public:
 	void removeItemFromList(Item *item, int32 oldx, int32 oldy);
 	void removeItem(Item *item);
 
+	//! Update the bounding box of an item in the map after it moved within
+	//! its chunk or changed shape
+	void updateItem(Item *item);
+
 	//! Update the fast area for the cameras position
 	void updateFastArea(int32 from_x, int32 from_y, int32 from_z, int32 to_x, int32 to_y, int32 to_z);
 
@@ -201,9 +205,54 @@ public:
 	void save(Common::WriteStream *ws);
 	bool load(Common::ReadStream *rs, uint32 version);
 
+	//! Number of collision and search queries since the last call to
+	//! resetQueryStats()
+	uint32 getQueryCount() const {
+		return _queryCount;
+	}
+
+	//! Number of items whose bounding boxes these queries tested
+	uint32 getItemsTested() const {
+		return _itemsTested;
+	}
+
+	//! Number of items these queries examined in detail, after their
+	//! bounding boxes matched
+	uint32 getItemsChecked() const {
+		return _itemsChecked;
+	}
+
+	void resetQueryStats();
+
 	INTRINSIC(I_canExistAt);
 
 private:
+	//! Bounding boxes of the items in a chunk, in the order of the item list.
+	//! They are kept in separate arrays so the queries can test them without
+	//! touching the items themselves. The x/y extent is the larger footpad
+	//! dimension, so a box stays valid when its item gets flipped.
+	struct ChunkIndex {
+		Std::vector<Item *> _item;
+		Std::vector<int32> _x, _y, _z;
+		Std::vector<int32> _xyd, _zd;
+		Std::vector<uint32> _shapeFlags;
+
+		void insert(uint pos, Item *item);
+		void set(uint pos, const Item *item);
+		void remove(uint pos);
+		int find(const Item *item) const;
+		void clear();
+
+		//! Does the box of the item at pos touch the given (inclusive) box?
+		bool touches(uint pos, int32 minx, int32 miny, int32 minz,
+		             int32 maxx, int32 maxy, int32 maxz) const {
+			return _x[pos] >= minx && _x[pos] - _xyd[pos] <= maxx &&
+			       _y[pos] >= miny && _y[pos] - _xyd[pos] <= maxy &&
+			       _z[pos] + _zd[pos] >= minz && _z[pos] <= maxz;
+		}
+	};
+
+
 	void loadItems(Std::list<Item *> itemlist, bool callCacheIn);
 	void createEggHatcher();
 
@@ -215,6 +264,11 @@ private:
 	// item lists. Lots of them :-)
 	// items[x][y]
 	Std::list<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+	ChunkIndex _index[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+
+	mutable uint32 _queryCount;
+	mutable uint32 _itemsTested;
+	mutable uint32 _itemsChecked;
 
 	ProcId _eggHatcher;
 
@@ -145,6 +145,9 @@ void Item::setLocation(int32 X, int32 Y, int32 Z) {
 	_x = X;
 	_y = Y;
 	_z = Z;
+
+	if (_extendedFlags & EXT_INCURMAP)
+		World::get_instance()->getCurrentMap()->updateItem(this);
 }
 
 void Item::move(int32 X, int32 Y, int32 Z) {
@@ -206,6 +209,9 @@ void Item::move(int32 X, int32 Y, int32 Z) {
 			map->addItemToEnd(this);
 		else
 			map->addItem(this);
+	} else {
+		// Still in the same chunk
+		map->updateItem(this);
 	}
 
 	// Call just moved
@@ -460,6 +466,9 @@ void Item::setShape(uint32 shape_) {
 	_shape = shape_;
 	_cachedShapeInfo = nullptr;
 	_cachedShape = nullptr;
+
+	if (_extendedFlags & EXT_INCURMAP)
+		World::get_instance()->getCurrentMap()->updateItem(this);
 }
 
 bool Item::overlaps(Item &item2) const {
@@ -30,6 +30,7 @@
 #include "ultima/ultima8/graphics/render_surface.h"
 #include "ultima/ultima8/misc/rect.h"
 #include "ultima/ultima8/games/game_data.h"
+#include "common/algorithm.h"
 
 // temp
 #include "ultima/ultima8/world/actors/weapon_overlay.h"
@@ -50,7 +51,8 @@ struct SortItem {
 			_syTop(0), _sxBot(0), _syBot(0),_f32x32(false), _flat(false),
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
-			_land(false), _occluded(false), _clipped(0) { }
+			_land(false), _occluded(false), _clipped(0), _listOrder(0),
+			_gridStamp(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -115,6 +117,9 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	int32   _listOrder;  // Place among the items with the same z, see ListBefore()
+	uint32  _gridStamp;  // Last grid lookup that found this item
+
 	// Note that Std::priority_queue could be used here, BUT there is no guarentee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Std::list, BUT there is no guarentee that it will keep wont delete
@@ -238,6 +243,19 @@ struct SortItem {
 		return _z < other->_z || (_z == other->_z && _flat);
 	}
 
+	// Order of the item list. Inserting each new item before the first one
+	// it is ListLessThan() puts the flats of a z level first, newest first,
+	// followed by the others in the order they were added.
+	inline bool ListBefore(const SortItem *other) const {
+		return _z < other->_z || (_z == other->_z && _listOrder < other->_listOrder);
+	}
+
+};
+
+struct SortItemListBefore {
+	bool operator()(const SortItem *si1, const SortItem *si2) const {
+		return si1->ListBefore(si2);
+	}
 };
 
 // Check to see if we overlap si2
@@ -580,9 +598,15 @@ inline bool SortItem::operator<<(const SortItem &si2) const {
 // ItemSorter
 //
 
+// Size of the cells of the screenspace grid, in pixels
+static const int32 GRID_CELL_SIZE = 64;
+
 ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
+	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0),
+	_gridX(0), _gridY(0), _gridW(0), _gridH(0), _gridStamp(0), _addCounter(0),
+	_listSorted(true), _reuseEnabled(true), _reusing(false), _reused(false),
+	_comparisons(0) {
 	int i = 2048;
 	while (i--) _itemsUnused = new SortItem(_itemsUnused);
 }
@@ -610,35 +634,144 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	// Get the _shapes, if required
 	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
 
-	//
+	// Screenspace bounding box bottom x coord (RNB x coord)
+	int32 camSx = (camx - camy) / 4;
+	// Screenspace bounding box bottom extent  (RNB y coord)
+	int32 camSy = (camx + camy) / 8 - camz;
+
+	Rect clip;
+	rs->GetClippingRect(clip);
+
+	// The previous list can only be kept if the same items end up at the
+	// same places on the screen
+	_reusing = _reuseEnabled && rs == _surf && camSx == _camSx && camSy == _camSy && clip == _clip;
+	_reused = false;
+	_comparisons = 0;
+	_prevAdded.swap(_added);
+	_added.resize(0);
+
+	// Set the RenderSurface, and reset the item list
+	_surf = rs;
+	_orderCounter = 0;
+	_camSx = camSx;
+	_camSy = camSy;
+	_clip = clip;
+
+	if (!_reusing)
+		ClearItems();
+}
+
+void ItemSorter::ClearItems() {
 	if (_itemsTail) {
 		_itemsTail->_next = _itemsUnused;
 		_itemsUnused = _items;
 	}
 	_items = nullptr;
 	_itemsTail = nullptr;
+	_addCounter = 0;
+	_listSorted = true;
+
+	// Cover the clipping rect with the grid. Items outside of it go into
+	// the cells at the edges.
+	_gridX = _clip.x;
+	_gridY = _clip.y;
+	_gridW = MAX<int32>(1, (_clip.w + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	_gridH = MAX<int32>(1, (_clip.h + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	if (_grid.size() != (uint)(_gridW * _gridH)) {
+		_grid.clear();
+		_grid.resize(_gridW * _gridH);
+	}
+	for (uint i = 0; i < _grid.size(); i++)
+		_grid[i].resize(0);
+}
 
-	// Set the RenderSurface, and reset the item list
-	_surf = rs;
-	_orderCounter = 0;
+void ItemSorter::StopReusing(uint count) {
+	_reusing = false;
+	ClearItems();
 
-	// Screenspace bounding box bottom x coord (RNB x coord)
-	_camSx = (camx - camy) / 4;
-	// Screenspace bounding box bottom extent  (RNB y coord)
-	_camSy = (camx + camy) / 8 - camz;
+	// Redo the calls that matched the previous frame
+	for (uint i = 0; i < count; i++)
+		AddSortItem(_added[i]);
+}
+
+void ItemSorter::EndDisplayList() {
+	if (_reusing) {
+		if (_added.size() != _prevAdded.size()) {
+			// Fewer items than before
+			StopReusing(_added.size());
+		} else {
+			// Everything is where it was, so only the painting has to be redone
+			_reusing = false;
+			_reused = true;
+			for (SortItem *si = _items; si != nullptr; si = si->_next)
+				si->_order = -1;
+		}
+	}
+
+	if (_listSorted)
+		return;
+
+	// Link the items in list order. There are no ties, so any sort will do.
+	_candidates.resize(0);
+	for (SortItem *si = _items; si != nullptr; si = si->_next)
+		_candidates.push_back(si);
+	Common::sort(_candidates.begin(), _candidates.end(), SortItemListBefore());
+
+	SortItem *prev = nullptr;
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si = _candidates[i];
+		si->_prev = prev;
+		if (prev)
+			prev->_next = si;
+		else
+			_items = si;
+		prev = si;
+	}
+	prev->_next = nullptr;
+	_itemsTail = prev;
+	_listSorted = true;
+}
+
+void ItemSorter::GetGridCells(const SortItem *si, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const {
+	// Overlapping items have overlapping screenspace extents
+	// [_sxLeft, _sxRight) and [_syTop, _syBot), see SortItem::overlap().
+	x1 = CLIP<int32>((si->_sxLeft - _gridX) / GRID_CELL_SIZE, 0, _gridW - 1);
+	y1 = CLIP<int32>((si->_syTop - _gridY) / GRID_CELL_SIZE, 0, _gridH - 1);
+	x2 = CLIP<int32>((MAX(si->_sxRight - 1, si->_sxLeft) - _gridX) / GRID_CELL_SIZE, 0, _gridW - 1);
+	y2 = CLIP<int32>((MAX(si->_syBot - 1, si->_syTop) - _gridY) / GRID_CELL_SIZE, 0, _gridH - 1);
 }
 
 void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
+	AddedItem added;
+	added._x = x;
+	added._y = y;
+	added._z = z;
+	added._shapeNum = shapeNum;
+	added._frameNum = frame_num;
+	added._flags = flags;
+	added._extFlags = ext_flags;
+	added._itemNum = itemNum;
+	_added.push_back(added);
+
+	if (_reusing) {
+		if (_added.size() <= _prevAdded.size() && added == _prevAdded[_added.size() - 1])
+			return;
+		StopReusing(_added.size() - 1);
+	}
+
+	AddSortItem(added);
+}
 
+void ItemSorter::AddSortItem(const AddedItem &added) {
 	// First thing, get a SortItem to use (first of unused)
 	if (!_itemsUnused)
 		_itemsUnused = new SortItem(0);
 	SortItem *si = _itemsUnused;
 
-	si->_itemNum = itemNum;
-	si->_shape = _shapes->getShape(shapeNum);
-	si->_shapeNum = shapeNum;
-	si->_frame = frame_num;
+	si->_itemNum = added._itemNum;
+	si->_shape = _shapes->getShape(added._shapeNum);
+	si->_shapeNum = added._shapeNum;
+	si->_frame = added._frameNum;
 	const ShapeFrame *_frame = si->_shape->getFrame(si->_frame);
 	if (!_frame) {
 		perr << "Invalid shape: " << si->_shapeNum << "," << si->_frame
@@ -646,18 +779,18 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 		return;
 	}
 
-	si->_flags = flags;
-	si->_extFlags = ext_flags;
+	si->_flags = added._flags;
+	si->_extFlags = added._extFlags;
 
-	const ShapeInfo *info = _shapes->getShapeInfo(shapeNum);
+	const ShapeInfo *info = _shapes->getShapeInfo(si->_shapeNum);
 	// Dimensions
 	int32 xd, yd, zd;
-	info->getFootpadWorld(xd, yd, zd, flags & Item::FLG_FLIPPED);
+	info->getFootpadWorld(xd, yd, zd, si->_flags & Item::FLG_FLIPPED);
 
 	// Worldspace bounding box
-	si->_x = x;
-	si->_y = y;
-	si->_z = z;
+	si->_x = added._x;
+	si->_y = added._y;
+	si->_z = added._z;
 	si->_xLeft = si->_x - xd;
 	si->_yFar = si->_y - yd;
 	si->_zTop = si->_z + zd;
@@ -712,17 +845,34 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	// Compare with the items sharing a grid cell, in list order
+	int32 x1, y1, x2, y2;
+	GetGridCells(si, x1, y1, x2, y2);
+
+	_gridStamp++;
+	_candidates.resize(0);
+	for (int32 cy = y1; cy <= y2; cy++) {
+		for (int32 cx = x1; cx <= x2; cx++) {
+			const Std::vector<SortItem *> &cell = _grid[cy * _gridW + cx];
+			for (uint i = 0; i < cell.size(); i++) {
+				SortItem *si2 = cell[i];
+				if (si2->_gridStamp != _gridStamp) {
+					si2->_gridStamp = _gridStamp;
+					_candidates.push_back(si2);
+				}
+			}
+		}
+	}
+	Common::sort(_candidates.begin(), _candidates.end(), SortItemListBefore());
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->ListLessThan(si2))
-			addpoint = si2;
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
 
 		// Doesn't overlap
-		if (si2->_occluded || !si->overlap(*si2))
+		if (si2->_occluded)
+			continue;
+		_comparisons++;
+		if (!si->overlap(*si2))
 			continue;
 
 		// Attempt to find which is infront
@@ -746,29 +896,25 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 		}
 	}
 
-	// Add it to the list
+	// Add it to the end of the list, it is put in place when the list is done
 	_itemsUnused = _itemsUnused->_next;
 
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
+	_addCounter++;
+	si->_listOrder = si->_flat ? -_addCounter : _addCounter;
+	if (_itemsTail)
+		_itemsTail->_next = si;
+	if (!_items)
+		_items = si;
+	si->_next = nullptr;
+	si->_prev = _itemsTail;
+	_itemsTail = si;
+	_listSorted = false;
+
+	// Occluded items are never compared again
+	if (!si->_occluded) {
+		for (int32 cy = y1; cy <= y2; cy++)
+			for (int32 cx = x1; cx <= x2; cx++)
+				_grid[cy * _gridW + cx].push_back(si);
 	}
 }
 
@@ -782,6 +928,8 @@ void ItemSorter::AddItem(const Item *add) {
 SortItem *_prev = 0;
 
 void ItemSorter::PaintDisplayList(bool item_highlight) {
+	EndDisplayList();
+
 	_prev = nullptr;
 	SortItem *it = _items;
 	SortItem *end = nullptr;
@@ -925,19 +1073,24 @@ bool ItemSorter::NullPaintSortItem(SortItem *si) {
 	return false;
 }
 
+void ItemSorter::SortDisplayList() {
+	EndDisplayList();
+
+	SortItem *it = _items;
+	_orderCounter = 0;  // Reset the _orderCounter
+	while (it != nullptr) {
+		if (it->_order == -1) if (NullPaintSortItem(it)) break;
+
+		it = it->_next;
+	}
+}
+
 uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
-	if (!_orderCounter) { // If no _orderCounter we need to sort the _items
-		it = _items;
-		_orderCounter = 0;  // Reset the _orderCounter
-		while (it != nullptr) {
-			if (it->_order == -1) if (NullPaintSortItem(it)) break;
-
-			it = it->_next;
-		}
-	}
+	if (!_orderCounter) // If no _orderCounter we need to sort the _items
+		SortDisplayList();
 
 	// Firstly, we check for highlighted _items
 	selected = nullptr;
@@ -23,6 +23,9 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "ultima/shared/std/containers.h"
+#include "ultima/ultima8/misc/rect.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -43,6 +46,40 @@ class ItemSorter {
 	int32       _orderCounter;
 
 	int32       _camSx, _camSy;
+	Rect        _clip;
+
+	// Screenspace grid over the bounding boxes of the items. Items only
+	// overlap when they share a cell, so only those get compared.
+	Std::vector<Std::vector<SortItem *> > _grid;
+	int32       _gridX, _gridY;     // Top left of the grid
+	int32       _gridW, _gridH;     // Size of the grid in cells
+	uint32      _gridStamp;         // Marks the items found by a lookup
+	Std::vector<SortItem *> _candidates;
+
+	int32       _addCounter;
+	bool        _listSorted;        // Whether _items is in painting order
+
+	// The AddItem() calls of this and the previous frame. As long as they
+	// are the same, the display list of the previous frame is kept.
+	struct AddedItem {
+		int32 _x, _y, _z;
+		uint32 _shapeNum, _frameNum;
+		uint32 _flags, _extFlags;
+		uint16 _itemNum;
+
+		bool operator==(const AddedItem &o) const {
+			return _x == o._x && _y == o._y && _z == o._z && _shapeNum == o._shapeNum &&
+			       _frameNum == o._frameNum && _flags == o._flags && _extFlags == o._extFlags &&
+			       _itemNum == o._itemNum;
+		}
+	};
+	Std::vector<AddedItem> _added;
+	Std::vector<AddedItem> _prevAdded;
+	bool        _reuseEnabled;
+	bool        _reusing;           // Whether the previous list may still be kept
+	bool        _reused;            // Whether the previous list was kept
+
+	uint32      _comparisons;       // Overlap checks for this display list
 
 public:
 	ItemSorter();
@@ -72,7 +109,31 @@ public:
 		if (_sortLimit > 0) _sortLimit--;
 	}
 
+	// Work out the painting order without painting. Done by Trace() when needed.
+	void SortDisplayList();
+
+	// Allow keeping the previous display list when nothing changed
+	void SetReuseEnabled(bool enabled) {
+		_reuseEnabled = enabled;
+	}
+
+	// Statistics of the current display list
+	int32 GetItemCount() const {
+		return _addCounter;
+	}
+	uint32 GetComparisons() const {
+		return _comparisons;
+	}
+	bool WasReused() const {
+		return _reused;
+	}
+
 private:
+	void AddSortItem(const AddedItem &);
+	void ClearItems();
+	void StopReusing(uint count);
+	void EndDisplayList();
+	void GetGridCells(const SortItem *, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const;
 	bool PaintSortItem(SortItem *);
 	bool NullPaintSortItem(SortItem *);
 };
@@ -134,6 +134,10 @@ public:
 	virtual bool drawShaderQuad() {
 		return STATUS_FAILED;
 	}
+	/**
+	 * Outline the areas of the screen that get redrawn, for debugging.
+	 */
+	virtual void setShowDirtyRects(bool show) {}
 
 	virtual float getScaleRatioX() const {
 		return 1.0f;
@@ -34,12 +34,14 @@
 #include "engines/wintermute/math/math_util.h"
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_sprite.h"
+#include "engines/wintermute/wintermute.h"
 #include "common/system.h"
 #include "graphics/transparent_surface.h"
 #include "common/queue.h"
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+#define TRANSFORM_CACHE_SIZE (2 * 1024 * 1024)
 
 namespace Wintermute {
 
@@ -48,7 +50,7 @@ BaseRenderer *makeOSystemRenderer(BaseGame *inGame) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
+BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame), _transformCache(TRANSFORM_CACHE_SIZE) {
 	_renderSurface = new Graphics::Surface();
 	_blankSurface = new Graphics::Surface();
 	_lastFrameIter = _renderQueue.end();
@@ -57,11 +59,18 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
 	}
+	_showDirtyRects = false;
+	if (ConfMan.hasKey("show_dirty_rects")) {
+		_showDirtyRects = ConfMan.getBool("show_dirty_rects");
+	}
+	_redrawnFrames = 0;
+	_redrawnPixels = 0;
+	_boundingPixels = 0;
+	_ticketBytes = 0;
 
 	_lastScreenChangeID = g_system->getScreenChangeID();
 }
@@ -75,8 +84,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -138,6 +145,8 @@ bool BaseRenderOSystem::initRenderer(int width, int height, bool windowed) {
 	_renderSurface->create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 	_blankSurface->create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 	_blankSurface->fillRect(Common::Rect(0, 0, _blankSurface->h, _blankSurface->w), _blankSurface->format.ARGBToColor(255, 0, 0, 0));
+	_dirtyRects.setBounds(_renderSurface->w, _renderSurface->h);
+	_dirtyBounds = Common::Rect(_renderSurface->w, _renderSurface->h);
 	_active = true;
 
 	_clearColor = _renderSurface->format.ARGBToColor(255, 0, 0, 0);
@@ -162,8 +171,8 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
+		_dirtyBounds = Common::Rect();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -202,13 +211,15 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		if (_disableDirtyRects) {
+			_dirtyRects.clear();
+			_dirtyBounds = Common::Rect();
+		}
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
 
+	logTicketStats();
 	g_system->updateScreen();
 
 	return STATUS_OK;
@@ -292,7 +303,7 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 
 	if (_disableDirtyRects) {
-		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+		RenderTicket *ticket = createTicket(owner, surf, srcRect, dstRect, transform);
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
 		drawFromSurface(ticket);
@@ -324,7 +335,7 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 			}
 		}
 	}
-	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+	RenderTicket *ticket = createTicket(owner, surf, srcRect, dstRect, transform);
 	if (!_disableDirtyRects) {
 		drawFromTicket(ticket);
 	} else {
@@ -334,13 +345,28 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 	}
 }
 
+RenderTicket *BaseRenderOSystem::createTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
+	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform, &_transformCache);
+	_ticketBytes += ticket->getAllocatedBytes();
+	return ticket;
+}
+
 void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 	addDirtyRect(renderTicket->_dstRect);
 	renderTicket->_isValid = false;
+	// Tickets still to be drawn this frame must show the pixels as they
+	// were when drawn, the others are never drawn again.
+	if (renderTicket->_wantsDraw) {
+		const uint32 allocated = renderTicket->getAllocatedBytes();
+		renderTicket->detachSurface();
+		_ticketBytes += renderTicket->getAllocatedBytes() - allocated;
+	}
 //	renderTicket->_canDelete = true; // TODO: Maybe readd this, to avoid even more duplicates.
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
+	_transformCache.purge(surf);
+
 	RenderQueueIterator it;
 	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 		if ((*it)->_owner == surf) {
@@ -386,12 +412,18 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
+	Common::Rect clipped(rect);
+	clipped.clip(_renderRect);
+	if (clipped.isEmpty()) {
+		return;
+	}
+
+	_dirtyRects.addRect(clipped);
+	if (_dirtyBounds.isEmpty()) {
+		_dirtyBounds = clipped;
 	} else {
-		_dirtyRect->extend(rect);
+		_dirtyBounds.extend(clipped);
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -410,7 +442,7 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -420,43 +452,71 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
+	// Redraw every dirty rect on its own, so two small changes far apart do
+	// not make everything between them be redrawn as well. The rects may
+	// overlap slightly, which only costs drawing that part twice.
+	// Everything being dirty means the whole screen, so clip to the viewport.
+	Common::Array<Common::Rect> dirtyRects;
+	uint32 redrawn = 0;
+	for (uint i = 0; i < _dirtyRects.getRects().size(); ++i) {
+		Common::Rect dirtyRect(_dirtyRects.getRects()[i]);
+		dirtyRect.clip(_renderRect);
+		if (!dirtyRect.isEmpty()) {
+			dirtyRects.push_back(dirtyRect);
+			redrawn += (uint32)dirtyRect.width() * dirtyRect.height();
+		}
+	}
 	_lastFrameIter = _renderQueue.end();
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+	const RenderTicket *opaqueTicket = nullptr;
+	if (!_renderQueue.empty() && _renderQueue.front() == _renderQueue.back() && _renderQueue.front()->_transform._alphaDisable == true) {
+		opaqueTicket = _renderQueue.front();
+	}
+	for (uint i = 0; i < dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyRect = dirtyRects[i];
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+		if (!opaqueTicket || !opaqueTicket->_dstRect.contains(dirtyRect)) {
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(dirtyRect, _clearColor);
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
-	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+			RenderTicket *ticket = *it;
+			if (ticket->_dstRect.intersects(dirtyRect)) {
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(dirtyRect);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				_needsFlip = true;
+			}
 		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
-		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+	// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		(*it)->_wantsDraw = false;
+	}
+
+	const uint32 bounding = (uint32)_dirtyBounds.width() * _dirtyBounds.height();
+	_redrawnFrames++;
+	_redrawnPixels += redrawn;
+	_boundingPixels += bounding;
+	debugC(1, kWintermuteDebugRender, "Frame %u: redrew %u pixels in %u rects, one bounding rect would be %u pixels (%u%% of that over all frames)",
+		_redrawnFrames, redrawn, dirtyRects.size(), bounding, (uint32)(_redrawnPixels * 100 / MAX<uint64>(_boundingPixels, 1)));
+
+	presentDirtyRects(dirtyRects);
+
+	// Anything made dirty from here on is for the next frame.
+	_dirtyRects.clear();
+	_dirtyBounds = Common::Rect();
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -473,6 +533,60 @@ void BaseRenderOSystem::drawTickets() {
 
 }
 
+void BaseRenderOSystem::logTicketStats() {
+	const uint32 lookups = _transformCache.getHits() + _transformCache.getMisses();
+	const uint32 allocated = _ticketBytes + _transformCache.getAllocatedBytes();
+	if (lookups || allocated) {
+		debugC(2, kWintermuteDebugRender, "Transform cache: %u of %u lookups hit, %u entries, %u bytes; %u bytes allocated for tickets",
+			_transformCache.getHits(), lookups, _transformCache.getEntryCount(), _transformCache.getSize(), allocated);
+	}
+	_transformCache.resetStats();
+	_ticketBytes = 0;
+}
+
+void BaseRenderOSystem::restoreOutlinedRects() {
+	for (uint i = 0; i < _outlinedRects.size(); ++i) {
+		const Common::Rect &r = _outlinedRects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(r.left, r.top), _renderSurface->pitch, r.left, r.top, r.width(), r.height());
+	}
+	_outlinedRects.clear();
+}
+
+void BaseRenderOSystem::presentDirtyRects(const Common::Array<Common::Rect> &rects) {
+	// Restore the pixels under the outlines of the last frame first.
+	restoreOutlinedRects();
+
+	for (uint i = 0; i < rects.size(); ++i) {
+		const Common::Rect &r = rects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(r.left, r.top), _renderSurface->pitch, r.left, r.top, r.width(), r.height());
+	}
+
+	if (!_showDirtyRects) {
+		return;
+	}
+
+	Graphics::Surface *screen = g_system->lockScreen();
+	if (!screen) {
+		return;
+	}
+	const uint32 color = screen->format.ARGBToColor(255, 255, 0, 255);
+	for (uint i = 0; i < rects.size(); ++i) {
+		screen->frameRect(rects[i], color);
+		_outlinedRects.push_back(rects[i]);
+	}
+	g_system->unlockScreen();
+}
+
+void BaseRenderOSystem::setShowDirtyRects(bool show) {
+	_showDirtyRects = show;
+
+	// Otherwise the outlines would stay until their area is redrawn. The
+	// next flip() puts the restored pixels on screen.
+	if (!show) {
+		restoreOutlinedRects();
+	}
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void BaseRenderOSystem::drawFromSurface(RenderTicket *ticket) {
 	ticket->drawToSurface(_renderSurface);
@@ -592,6 +706,7 @@ void BaseRenderOSystem::endSaveLoad() {
 		it = _renderQueue.erase(it);
 		delete ticket;
 	}
+	_transformCache.clear();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
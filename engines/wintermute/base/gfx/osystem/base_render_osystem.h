@@ -33,7 +33,9 @@
 #include "common/rect.h"
 #include "graphics/surface.h"
 #include "common/list.h"
+#include "graphics/dirtyrects.h"
 #include "graphics/transform_struct.h"
+#include "engines/wintermute/base/gfx/osystem/transform_cache.h"
 
 namespace Wintermute {
 class BaseSurfaceOSystem;
@@ -113,6 +115,7 @@ public:
 	bool startSpriteBatch() override;
 	bool endSpriteBatch() override;
 	void endSaveLoad() override;
+	void setShowDirtyRects(bool show) override;
 	void drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
 	BaseSurface *createSurface() override;
 private:
@@ -125,13 +128,43 @@ private:
 	 * Traverse the tickets that are dirty, and draw them
 	 */
 	void drawTickets();
+	/**
+	 * Copy the redrawn areas to the screen, outlining them if requested.
+	 */
+	void presentDirtyRects(const Common::Array<Common::Rect> &rects);
+	/**
+	 * Copy the areas outlined by presentDirtyRects() to the screen again,
+	 * without their outlines.
+	 */
+	void restoreOutlinedRects();
 	// Non-dirty-rects:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	/**
+	 * Create a ticket, taking transformed pixels from the cache.
+	 */
+	RenderTicket *createTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
+	/**
+	 * Report how well the transform cache did and what tickets allocated this frame.
+	 */
+	void logTicketStats();
+	Graphics::DirtyRectList _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
 
+	// What a single dirty rect covering all changes would have been, for
+	// the statistics.
+	Common::Rect _dirtyBounds;
+	uint32 _redrawnFrames;
+	uint64 _redrawnPixels;
+	uint64 _boundingPixels;
+
+	bool _showDirtyRects;
+	Common::Array<Common::Rect> _outlinedRects;
+
+	TransformCache _transformCache;
+	uint32 _ticketBytes; // Allocated by tickets outside the cache this frame
+
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
 	Common::Rect _renderRect;
@@ -55,6 +55,10 @@ BaseSurfaceOSystem::BaseSurfaceOSystem(BaseGame *inGame) : BaseSurface(inGame) {
 
 //////////////////////////////////////////////////////////////////////////
 BaseSurfaceOSystem::~BaseSurfaceOSystem() {
+	// Tickets may refer to our pixels, so let them go first.
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
+	renderer->invalidateTicketsFromSurface(this);
+
 	if (_surface) {
 		_surface->free();
 		delete _surface;
@@ -65,8 +69,6 @@ BaseSurfaceOSystem::~BaseSurfaceOSystem() {
 	_alphaMask = nullptr;
 
 	_gameRef->addMem(-_width * _height * 4);
-	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
-	renderer->invalidateTicketsFromSurface(this);
 }
 
 Graphics::AlphaType hasTransparencyType(const Graphics::Surface *surf) {
@@ -462,6 +464,10 @@ bool BaseSurfaceOSystem::drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect,
 }
 
 bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAlpha) {
+	// Tickets may refer to the pixels that are replaced here.
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
+	renderer->invalidateTicketsFromSurface(this);
+
 	_loaded = true;
 	if (surface.format == _surface->format && surface.pitch == _surface->pitch && surface.h == _surface->h) {
 		const byte *src = (const byte *)surface.getBasePtr(0, 0);
@@ -476,8 +482,6 @@ bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAl
 	} else {
 		_alphaType = Graphics::ALPHA_OPAQUE;
 	}
-	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
-	renderer->invalidateTicketsFromSurface(this);
 
 	return STATUS_OK;
 }
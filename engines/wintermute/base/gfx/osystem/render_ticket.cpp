@@ -35,64 +35,47 @@
 
 namespace Wintermute {
 
-RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct transform) :
+RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct transform, TransformCache *cache) :
 	_owner(owner),
 	_srcRect(*srcRect),
 	_dstRect(*dstRect),
 	_isValid(true),
 	_wantsDraw(true),
-	_transform(transform) {
-	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
-		assert(_surface->format.bytesPerPixel == 4);
-		// Get a clipped copy of the surface
-		for (int i = 0; i < _surface->h; i++) {
-			memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
-		}
-		// Then scale it if necessary
-		//
-		// NB: The numTimesX/numTimesY properties don't yet mix well with
-		// scaling and rotation, but there is no need for that functionality at
-		// the moment.
-		// NB: Mirroring and rotation are probably done in the wrong order.
-		// (Mirroring should most likely be done before rotation. See also
-		// TransformTools.)
-		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp;
-			if (owner->_gameRef->getBilinearFiltering()) {
-				temp = src.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
-			} else {
-				temp = src.rotoscaleT<Graphics::FILTER_NEAREST>(transform);
-			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
-		} else if ((dstRect->width() != srcRect->width() ||
-					dstRect->height() != srcRect->height()) &&
-					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp;
-			if (owner->_gameRef->getBilinearFiltering()) {
-				temp = src.scaleT<Graphics::FILTER_BILINEAR>(dstRect->width(), dstRect->height());
-			} else {
-				temp = src.scaleT<Graphics::FILTER_NEAREST>(dstRect->width(), dstRect->height());
-			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+	_transform(transform),
+	_allocatedBytes(0) {
+	if (!surf) {
+		return;
+	}
+
+	assert(surf->format.bytesPerPixel == 4);
+	if (TransformCache::needsTransform(*srcRect, *dstRect, _transform)) {
+		const bool bilinear = owner && owner->_gameRef->getBilinearFiltering();
+		if (owner && cache) {
+			_surface = cache->get(owner, *surf, *srcRect, *dstRect, _transform, bilinear);
+		} else {
+			_surface = TransformCache::transform(*surf, *srcRect, *dstRect, _transform, bilinear);
+			_allocatedBytes = _surface->pitch * _surface->h;
 		}
 	} else {
-		_surface = nullptr;
+		// Refer to the clipped area of the surface. Owner-less tickets are
+		// drawn from temporary surfaces, so take a copy of those right away.
+		_view.init((uint16)srcRect->width(), (uint16)srcRect->height(), surf->pitch,
+		           const_cast<void *>(surf->getBasePtr(srcRect->left, srcRect->top)), surf->format);
+		if (!owner) {
+			detachSurface();
+		}
 	}
 }
 
-RenderTicket::~RenderTicket() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
+void RenderTicket::detachSurface() {
+	if (_surface || !_view.getPixels()) {
+		return;
 	}
+
+	Graphics::Surface *copy = new Graphics::Surface();
+	copy->copyFrom(_view);
+	_surface = TransformCache::SurfacePtr(copy, Graphics::SurfaceDeleter());
+	_allocatedBytes += copy->pitch * copy->h;
 }
 
 bool RenderTicket::operator==(const RenderTicket &t) const {
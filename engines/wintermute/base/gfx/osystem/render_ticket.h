@@ -29,6 +29,7 @@
 #ifndef WINTERMUTE_RENDER_TICKET_H
 #define WINTERMUTE_RENDER_TICKET_H
 
+#include "engines/wintermute/base/gfx/osystem/transform_cache.h"
 #include "graphics/transparent_surface.h"
 #include "graphics/surface.h"
 #include "common/rect.h"
@@ -48,13 +49,25 @@ class BaseSurfaceOSystem;
  * (Video-surfaces may even change their data). The promise that is made when a ticket
  * is created is that what the state was of the surface at THAT point, is what will end
  * up on screen at flip() time.
+ *
+ * Tickets that need no rotation or scaling refer to the pixels of their owner
+ * instead of copying them, and only take a copy through detachSurface() when the
+ * owner is about to change them. Rotated and scaled pixels come from a
+ * TransformCache when one is given.
  */
 class RenderTicket {
 public:
-	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
-	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
-	~RenderTicket();
-	const Graphics::Surface *getSurface() const { return _surface; }
+	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform, TransformCache *cache = nullptr);
+	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()), _allocatedBytes(0) {}
+	const Graphics::Surface *getSurface() const { return _surface ? _surface.get() : &_view; }
+	/**
+	 * Copy the owner's pixels the ticket refers to, as they are about to change.
+	 */
+	void detachSurface();
+	/**
+	 * The number of bytes the ticket allocated for pixels of its own.
+	 */
+	uint32 getAllocatedBytes() const { return _allocatedBytes; }
 	// Non-dirty-rects:
 	void drawToSurface(Graphics::Surface *_targetSurface) const;
 	// Dirty-rects:
@@ -71,8 +84,11 @@ public:
 	bool operator==(const RenderTicket &a) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
-	Graphics::Surface *_surface;
+	// Copied or transformed pixels. When empty, _view refers to those of the owner.
+	TransformCache::SurfacePtr _surface;
+	Graphics::Surface _view;
 	Common::Rect _srcRect;
+	uint32 _allocatedBytes;
 };
 
 } // End of namespace Wintermute
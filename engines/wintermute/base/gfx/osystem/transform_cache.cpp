@@ -0,0 +1,147 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/wintermute/base/gfx/osystem/transform_cache.h"
+#include "graphics/transparent_surface.h"
+
+namespace Wintermute {
+
+TransformCache::TransformCache(uint32 maxBytes) : _maxBytes(maxBytes), _size(0), _useCounter(0), _hits(0), _misses(0), _allocatedBytes(0) {
+}
+
+TransformCache::~TransformCache() {
+	clear();
+}
+
+bool TransformCache::needsTransform(const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform) {
+	// NB: The numTimesX/numTimesY properties don't yet mix well with
+	// scaling and rotation, but there is no need for that functionality at
+	// the moment.
+	if (transform._angle != Graphics::kDefaultAngle) {
+		return true;
+	}
+	return (dstRect.width() != srcRect.width() || dstRect.height() != srcRect.height()) &&
+	       transform._numTimesX * transform._numTimesY == 1;
+}
+
+TransformCache::SurfacePtr TransformCache::transform(const Graphics::Surface &surf, const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, bool bilinear) {
+	// The transformations expect the area on its own, without any pitch
+	// beyond its width, so get a clipped copy of the surface first.
+	Graphics::TransparentSurface src;
+	src.create((uint16)srcRect.width(), (uint16)srcRect.height(), surf.format);
+	assert(src.format.bytesPerPixel == 4);
+	for (int i = 0; i < src.h; i++) {
+		memcpy(src.getBasePtr(0, i), surf.getBasePtr(srcRect.left, srcRect.top + i), srcRect.width() * src.format.bytesPerPixel);
+	}
+
+	// NB: Mirroring and rotation are probably done in the wrong order.
+	// (Mirroring should most likely be done before rotation. See also
+	// TransformTools.)
+	Graphics::Surface *result;
+	if (transform._angle != Graphics::kDefaultAngle) {
+		if (bilinear) {
+			result = src.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
+		} else {
+			result = src.rotoscaleT<Graphics::FILTER_NEAREST>(transform);
+		}
+	} else {
+		if (bilinear) {
+			result = src.scaleT<Graphics::FILTER_BILINEAR>(dstRect.width(), dstRect.height());
+		} else {
+			result = src.scaleT<Graphics::FILTER_NEAREST>(dstRect.width(), dstRect.height());
+		}
+	}
+	src.free();
+
+	return SurfacePtr(result, Graphics::SurfaceDeleter());
+}
+
+TransformCache::SurfacePtr TransformCache::get(const BaseSurfaceOSystem *owner, const Graphics::Surface &surf, const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, bool bilinear) {
+	Key key;
+	key.owner = owner;
+	key.srcRect = srcRect;
+	key.width = dstRect.width();
+	key.height = dstRect.height();
+	key.angle = transform._angle;
+	key.zoom = transform._zoom;
+	key.hotspot = transform._hotspot;
+	key.bilinear = bilinear;
+
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end()) {
+		i->_value.lastUse = ++_useCounter;
+		++_hits;
+		return i->_value.surface;
+	}
+
+	++_misses;
+	Entry entry;
+	entry.surface = TransformCache::transform(surf, srcRect, dstRect, transform, bilinear);
+	entry.lastUse = ++_useCounter;
+
+	const uint32 size = entrySize(*entry.surface);
+	_allocatedBytes += size;
+	if (size > _maxBytes / 4) {
+		// Too large to be worth pushing everything else out
+		return entry.surface;
+	}
+
+	evict(size);
+	_entries[key] = entry;
+	_size += size;
+	return entry.surface;
+}
+
+void TransformCache::purge(const BaseSurfaceOSystem *owner) {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		if (i->_key.owner == owner) {
+			_size -= entrySize(*i->_value.surface);
+			_entries.erase(i);
+		}
+	}
+}
+
+void TransformCache::clear() {
+	_entries.clear();
+	_size = 0;
+}
+
+void TransformCache::resetStats() {
+	_hits = 0;
+	_misses = 0;
+	_allocatedBytes = 0;
+}
+
+void TransformCache::evict(uint32 neededBytes) {
+	while (!_entries.empty() && _size + neededBytes > _maxBytes) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+
+		_size -= entrySize(*oldest->_value.surface);
+		_entries.erase(oldest);
+	}
+}
+
+} // End of namespace Wintermute
@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef WINTERMUTE_TRANSFORM_CACHE_H
+#define WINTERMUTE_TRANSFORM_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/ptr.h"
+#include "common/rect.h"
+#include "graphics/surface.h"
+#include "graphics/transform_struct.h"
+
+namespace Wintermute {
+
+class BaseSurfaceOSystem;
+
+/**
+ * Keeps the results of rotating and scaling areas of surfaces, so sprites
+ * drawn with the same transform frame after frame are only transformed once.
+ *
+ * Results are shared with the render tickets using them, so dropping one
+ * from the cache never pulls pixels away from a ticket. The cache holds at
+ * most a given number of bytes and drops the least recently used results
+ * first. Results of a surface must be purged whenever its pixels change.
+ */
+class TransformCache {
+public:
+	typedef Common::SharedPtr<Graphics::Surface> SurfacePtr;
+
+	TransformCache(uint32 maxBytes);
+	~TransformCache();
+
+	/**
+	 * Whether drawing srcRect to dstRect with the transform needs a
+	 * rotated or scaled copy of the pixels.
+	 */
+	static bool needsTransform(const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform);
+
+	/**
+	 * Rotate or scale srcRect of surf as needed to draw it to dstRect.
+	 */
+	static SurfacePtr transform(const Graphics::Surface &surf, const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, bool bilinear);
+
+	/**
+	 * Like transform(), but reusing the result of an earlier call for the
+	 * same area of the owner's surface.
+	 */
+	SurfacePtr get(const BaseSurfaceOSystem *owner, const Graphics::Surface &surf, const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, bool bilinear);
+
+	/**
+	 * Drop all results for the owner, e.g. after its pixels changed.
+	 */
+	void purge(const BaseSurfaceOSystem *owner);
+	void clear();
+
+	uint32 getSize() const { return _size; }
+	uint getEntryCount() const { return _entries.size(); }
+
+	// Statistics since the last call to resetStats()
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getAllocatedBytes() const { return _allocatedBytes; }
+	void resetStats();
+
+private:
+	struct Key {
+		const BaseSurfaceOSystem *owner;
+		Common::Rect srcRect;
+		int16 width, height;
+		int32 angle;
+		Common::Point zoom;
+		Common::Point hotspot;
+		bool bilinear;
+
+		bool operator==(const Key &other) const {
+			return owner == other.owner && srcRect == other.srcRect && width == other.width && height == other.height &&
+			       angle == other.angle && zoom == other.zoom && hotspot == other.hotspot && bilinear == other.bilinear;
+		}
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			uint hash = (uint)(size_t)key.owner * 2654435761U;
+			hash = hash * 31 + (((uint)(uint16)key.srcRect.left << 16) | (uint16)key.srcRect.top);
+			hash = hash * 31 + (((uint)(uint16)key.width << 16) | (uint16)key.height);
+			hash = hash * 31 + (uint)key.angle;
+			hash = hash * 31 + (((uint)(uint16)key.zoom.x << 16) | (uint16)key.zoom.y);
+			return hash;
+		}
+	};
+
+	struct Entry {
+		SurfacePtr surface;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	static uint32 entrySize(const Graphics::Surface &surface) { return surface.pitch * surface.h; }
+
+	void evict(uint32 neededBytes);
+
+	EntryMap _entries;
+	uint32 _maxBytes;
+	uint32 _size;
+	uint32 _useCounter;
+	uint32 _hits, _misses;
+	uint32 _allocatedBytes;
+};
+
+} // End of namespace Wintermute
+
+#endif
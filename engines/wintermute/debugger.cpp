@@ -36,6 +36,7 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("show_dirty_rects", WRAP_METHOD(Console, Cmd_ShowDirtyRects));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -308,6 +309,21 @@ bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_ShowDirtyRects(int argc, const char **argv) {
+	if (argc == 2) {
+		if (Common::String(argv[1]) == "true") {
+			CONTROLLER->showDirtyRects(true);
+		} else if (Common::String(argv[1]) == "false") {
+			CONTROLLER->showDirtyRects(false);
+		} else {
+			debugPrintf("%s: argument 1 must be \"true\" or \"false\"\n", argv[0]);
+		}
+	} else {
+		debugPrintf("Usage: %s [true|false]\n", argv[0]);
+	}
+	return true;
+}
+
 bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Usage: %s <file path> <output file name>\n", argv[0]);
@@ -44,7 +44,8 @@ enum {
 	kWintermuteDebugFont = 1 << 2, // next new channel must be 1 << 2 (4)
 	kWintermuteDebugFileAccess = 1 << 3, // the current limitation is 32 debug channels (1 << 31 is the last one)
 	kWintermuteDebugAudio = 1 << 4,
-	kWintermuteDebugGeneral = 1 << 5
+	kWintermuteDebugGeneral = 1 << 5,
+	kWintermuteDebugRender = 1 << 6
 };
 
 enum WintermuteGameFeatures {
@@ -33,7 +33,21 @@ namespace Graphics {
  * DRAWSTEP handling functions
  ********************************************************************/
 void VectorRenderer::drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra) {
+	setStepColors(step);
 
+	setShadowOffset(_disableShadows ? 0 : step.shadow);
+	setBevel(step.bevel);
+	setGradientFactor(step.factor);
+	setStrokeWidth(step.stroke);
+	setFillMode((FillMode)step.fillMode);
+	setClippingRect(applyStepClippingRect(area, clip, step));
+
+	_dynamicData = extra;
+
+	(this->*(step.drawingCall))(area, step);
+}
+
+void VectorRenderer::setStepColors(const DrawStep &step) {
 	if (step.bgColor.set)
 		setBgColor(step.bgColor.r, step.bgColor.g, step.bgColor.b);
 
@@ -46,17 +60,6 @@ void VectorRenderer::drawStep(const Common::Rect &area, const Common::Rect &clip
 	if (step.gradColor1.set && step.gradColor2.set)
 		setGradientColors(step.gradColor1.r, step.gradColor1.g, step.gradColor1.b,
 			step.gradColor2.r, step.gradColor2.g, step.gradColor2.b);
-
-	setShadowOffset(_disableShadows ? 0 : step.shadow);
-	setBevel(step.bevel);
-	setGradientFactor(step.factor);
-	setStrokeWidth(step.stroke);
-	setFillMode((FillMode)step.fillMode);
-	setClippingRect(applyStepClippingRect(area, clip, step));
-
-	_dynamicData = extra;
-
-	(this->*(step.drawingCall))(area, step);
 }
 
 Common::Rect VectorRenderer::applyStepClippingRect(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step) {
@@ -286,6 +286,19 @@ public:
 	 */
 	virtual void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) = 0;
 
+	enum {
+		kColorStateSize = 6 ///< Number of values stored by getColorState()
+	};
+
+	/**
+	 * Stores the colors currently set, which draw steps that do not set
+	 * all colors themselves continue to use. Drawing the same steps into
+	 * the same area with the same color state gives the same result.
+	 *
+	 * @param state Array of kColorStateSize values.
+	 */
+	virtual void getColorState(uint32 *state) const = 0;
+
 	/**
 	 * Sets the active drawing surface. All drawing from this
 	 * point on will be done on that surface.
@@ -478,6 +491,12 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Sets the colors specified by a draw step, as drawStep() does before
+	 * drawing it.
+	 */
+	void setStepColors(const DrawStep &step);
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
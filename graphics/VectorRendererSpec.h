@@ -73,6 +73,14 @@ public:
 	void setBgColor(uint8 r, uint8 g, uint8 b) override { _bgColor = _format.RGBToColor(r, g, b); }
 	void setBevelColor(uint8 r, uint8 g, uint8 b) override { _bevelColor = _format.RGBToColor(r, g, b); }
 	void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) override;
+	void getColorState(uint32 *state) const override {
+		state[0] = _fgColor;
+		state[1] = _bgColor;
+		state[2] = _gradientStart;
+		state[3] = _gradientEnd;
+		state[4] = _bevelColor;
+		state[5] = _bitmapAlphaColor;
+	}
 	void setClippingRect(const Common::Rect &clippingArea) override { _clippingArea = clippingArea; }
 
 	void copyFrame(OSystem *sys, const Common::Rect &r) override;
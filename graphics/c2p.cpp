@@ -0,0 +1,234 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/c2p.h"
+#include "common/endian.h"
+
+namespace Graphics {
+
+namespace {
+
+void referenceSpan(const byte *src, int16 x, int16 y, int16 width, PlanarBitmap &dst) {
+	const uint32 rowOffset = (uint32)y * dst.bytesPerRow;
+
+	for (int16 i = 0; i < width; ++i, ++x) {
+		const byte color = src[i];
+		const uint32 offset = rowOffset + (x >> 3);
+		const byte bit = 0x80 >> (x & 7);
+
+		for (byte p = 0; p < dst.depth; ++p) {
+			if (color & (1 << p))
+				dst.planes[p][offset] |= bit;
+			else
+				dst.planes[p][offset] &= ~bit;
+		}
+	}
+}
+
+inline void merge(uint32 &a, uint32 &b, int shift, uint32 mask) {
+	const uint32 t = ((a >> shift) ^ b) & mask;
+	b ^= t;
+	a ^= t << shift;
+}
+
+// The merges below leave the bits of plane kPlaneOfWord[i] in word i.
+const byte kPlaneOfWord[8] = { 0, 4, 1, 5, 2, 6, 3, 7 };
+
+/**
+ * Converts 32 pixels starting at a multiple of 32.
+ *
+ * The 32x8 bit matrix formed by the pixels is transposed with five merge
+ * passes. Each pass swaps one bit of the word index with one bit of the
+ * position inside the words; loading the words in reverse order takes care
+ * of the leftmost pixel ending up in the most significant bit.
+ */
+void mergeGroup(const byte *src, int16 x, int16 y, PlanarBitmap &dst) {
+	uint32 w[8];
+	for (int i = 0; i < 8; ++i)
+		w[7 - i] = READ_BE_UINT32(src + i * 4);
+
+	merge(w[0], w[4], 16, 0x0000ffff);
+	merge(w[1], w[5], 16, 0x0000ffff);
+	merge(w[2], w[6], 16, 0x0000ffff);
+	merge(w[3], w[7], 16, 0x0000ffff);
+
+	merge(w[0], w[2], 8, 0x00ff00ff);
+	merge(w[1], w[3], 8, 0x00ff00ff);
+	merge(w[4], w[6], 8, 0x00ff00ff);
+	merge(w[5], w[7], 8, 0x00ff00ff);
+
+	merge(w[0], w[1], 4, 0x0f0f0f0f);
+	merge(w[2], w[3], 4, 0x0f0f0f0f);
+	merge(w[4], w[5], 4, 0x0f0f0f0f);
+	merge(w[6], w[7], 4, 0x0f0f0f0f);
+
+	merge(w[0], w[4], 2, 0x33333333);
+	merge(w[1], w[5], 2, 0x33333333);
+	merge(w[2], w[6], 2, 0x33333333);
+	merge(w[3], w[7], 2, 0x33333333);
+
+	merge(w[0], w[2], 1, 0x55555555);
+	merge(w[1], w[3], 1, 0x55555555);
+	merge(w[4], w[6], 1, 0x55555555);
+	merge(w[5], w[7], 1, 0x55555555);
+
+	const uint32 offset = (uint32)y * dst.bytesPerRow + (x >> 3);
+	for (int i = 0; i < 8; ++i) {
+		const byte plane = kPlaneOfWord[i];
+		if (plane < dst.depth)
+			WRITE_BE_UINT32(dst.planes[plane] + offset, w[i]);
+	}
+}
+
+} // End of anonymous namespace
+
+ChunkyToPlanar::ChunkyToPlanar(C2PMethod method)
+	: _method(method), _deltaMode(false), _previousValid(false), _groupsWritten(0), _groupsSkipped(0) {
+}
+
+ChunkyToPlanar::~ChunkyToPlanar() {
+	_previous.free();
+}
+
+void ChunkyToPlanar::setDeltaMode(bool enable) {
+	_deltaMode = enable;
+	_previous.free();
+	_previousValid = false;
+}
+
+void ChunkyToPlanar::invalidate() {
+	_previousValid = false;
+}
+
+void ChunkyToPlanar::convert(const Surface &src, PlanarBitmap &dst) {
+	convert(src, Common::Rect(src.w, src.h), dst);
+}
+
+void ChunkyToPlanar::convert(const Surface &src, const Common::Rect &area, PlanarBitmap &dst) {
+	assert(src.format.bytesPerPixel == 1);
+	assert(dst.depth <= 8);
+	assert(src.w <= dst.bytesPerRow * 8 && src.h <= dst.rows);
+
+	Common::Rect r = area;
+	r.clip(src.w, src.h);
+	if (r.isEmpty())
+		return;
+
+	if (!_deltaMode) {
+		for (int16 y = r.top; y < r.bottom; ++y)
+			convertRow((const byte *)src.getBasePtr(r.left, y), r.left, y, r.width(), dst);
+		return;
+	}
+
+	if (!_previous.getPixels() || _previous.w != src.w || _previous.h != src.h) {
+		_previous.create(src.w, src.h, src.format);
+		_previousValid = false;
+	}
+
+	// Compare whole groups, since the bitmap is written in whole groups.
+	r.left &= ~31;
+	r.right = MIN<int16>((r.right + 31) & ~31, src.w);
+
+	for (int16 y = r.top; y < r.bottom; ++y) {
+		const byte *srcRow = (const byte *)src.getBasePtr(0, y);
+		byte *prevRow = (byte *)_previous.getBasePtr(0, y);
+
+		// Convert runs of changed groups in one go.
+		int16 runStart = -1;
+		for (int16 x = r.left; x < r.right; x += 32) {
+			const int16 width = MIN<int16>(32, r.right - x);
+			const bool changed = !_previousValid || memcmp(srcRow + x, prevRow + x, width) != 0;
+
+			if (changed) {
+				if (runStart < 0)
+					runStart = x;
+			} else {
+				++_groupsSkipped;
+				if (runStart >= 0) {
+					convertRow(srcRow + runStart, runStart, y, x - runStart, dst);
+					runStart = -1;
+				}
+			}
+		}
+
+		if (runStart >= 0)
+			convertRow(srcRow + runStart, runStart, y, r.right - runStart, dst);
+
+		memcpy(prevRow + r.left, srcRow + r.left, r.width());
+	}
+
+	// Areas outside of r are still unknown when starting without a valid
+	// previous frame.
+	if (!_previousValid)
+		_previousValid = (r == Common::Rect(src.w, src.h));
+}
+
+void ChunkyToPlanar::convertRow(const byte *src, int16 x, int16 y, int16 width, PlanarBitmap &dst) {
+	_groupsWritten += ((x + width + 31) >> 5) - (x >> 5);
+
+	if (_method == kC2PReference) {
+		referenceSpan(src, x, y, width, dst);
+		return;
+	}
+
+	// Leading pixels up to the first whole group.
+	const int16 head = MIN<int16>((32 - (x & 31)) & 31, width);
+	if (head) {
+		referenceSpan(src, x, y, head, dst);
+		src += head;
+		x += head;
+		width -= head;
+	}
+
+	while (width >= 32) {
+		mergeGroup(src, x, y, dst);
+		src += 32;
+		x += 32;
+		width -= 32;
+	}
+
+	if (width)
+		referenceSpan(src, x, y, width, dst);
+}
+
+void planarToChunky(const PlanarBitmap &src, Surface &dst) {
+	assert(dst.format.bytesPerPixel == 1);
+
+	for (int16 y = 0; y < dst.h; ++y) {
+		byte *out = (byte *)dst.getBasePtr(0, y);
+		const uint32 rowOffset = (uint32)y * src.bytesPerRow;
+
+		for (int16 x = 0; x < dst.w; ++x) {
+			const uint32 offset = rowOffset + (x >> 3);
+			const byte bit = 0x80 >> (x & 7);
+
+			byte color = 0;
+			for (byte p = 0; p < src.depth; ++p) {
+				if (src.planes[p][offset] & bit)
+					color |= 1 << p;
+			}
+			out[x] = color;
+		}
+	}
+}
+
+} // End of namespace Graphics
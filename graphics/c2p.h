@@ -0,0 +1,124 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_C2P_H
+#define GRAPHICS_C2P_H
+
+#include "common/rect.h"
+#include "graphics/surface.h"
+
+namespace Graphics {
+
+/**
+ * A bitmap stored as separate bitplanes, laid out like an Amiga BitMap:
+ * bit 7 of the first byte of a row is its leftmost pixel, and bit n of a
+ * pixel's color lives in planes[n].
+ */
+struct PlanarBitmap {
+	PlanarBitmap() : bytesPerRow(0), rows(0), depth(0) {
+		for (int i = 0; i < 8; ++i)
+			planes[i] = nullptr;
+	}
+
+	uint16 bytesPerRow;
+	uint16 rows;
+	byte depth;
+	byte *planes[8];
+};
+
+enum C2PMethod {
+	/** Plain per pixel conversion, kept as the reference to test against */
+	kC2PReference,
+	/** Converts 32 pixels at once by merging their bits into plane words */
+	kC2PMerge
+};
+
+/**
+ * Converts 8-bit chunky surfaces into a PlanarBitmap.
+ *
+ * The merge method handles groups of 32 pixels starting at multiples of 32;
+ * what does not fill a whole group falls back to the reference code.
+ *
+ * In delta mode a copy of the last converted chunky data is kept, and groups
+ * which did not change since are not written again. Since that comparison
+ * is against what was written before, use one converter per destination
+ * bitmap, e.g. one per screen buffer.
+ */
+class ChunkyToPlanar {
+public:
+	ChunkyToPlanar(C2PMethod method = kC2PMerge);
+	~ChunkyToPlanar();
+
+	void setMethod(C2PMethod method) { _method = method; }
+	C2PMethod getMethod() const { return _method; }
+
+	/**
+	 * Enable or disable delta mode. Enabling it forgets the last frame, so
+	 * the next conversion writes everything.
+	 */
+	void setDeltaMode(bool enable);
+	bool getDeltaMode() const { return _deltaMode; }
+
+	/**
+	 * Forget the last frame in delta mode, e.g. after the destination
+	 * bitmap was changed behind our back.
+	 */
+	void invalidate();
+
+	/**
+	 * Convert a whole surface. The bitmap must be at least as large.
+	 */
+	void convert(const Surface &src, PlanarBitmap &dst);
+
+	/**
+	 * Convert the given area of a surface to the same position in the bitmap.
+	 * In delta mode, the area is widened to whole 32 pixel groups.
+	 */
+	void convert(const Surface &src, const Common::Rect &area, PlanarBitmap &dst);
+
+	/** Number of 32 pixel groups written since the last resetStats() */
+	uint32 getGroupsWritten() const { return _groupsWritten; }
+	/** Number of 32 pixel groups skipped by delta mode since the last resetStats() */
+	uint32 getGroupsSkipped() const { return _groupsSkipped; }
+	void resetStats() { _groupsWritten = _groupsSkipped = 0; }
+
+private:
+	void convertRow(const byte *src, int16 x, int16 y, int16 width, PlanarBitmap &dst);
+
+	C2PMethod _method;
+	bool _deltaMode;
+	Surface _previous;
+	bool _previousValid;
+
+	uint32 _groupsWritten;
+	uint32 _groupsSkipped;
+};
+
+/**
+ * Convert a PlanarBitmap back into an 8-bit chunky surface of the same size,
+ * for verification.
+ */
+void planarToChunky(const PlanarBitmap &src, Surface &dst);
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,194 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/dirtyrects.h"
+
+namespace Graphics {
+
+DirtyRectList::DirtyRectList(uint maxRects) : _maxRects(maxRects), _xAlign(1), _allDirty(false) {
+	assert(maxRects > 0);
+}
+
+void DirtyRectList::setBounds(int16 width, int16 height) {
+	_bounds = Common::Rect(width, height);
+	markAll();
+}
+
+void DirtyRectList::setAlignment(uint16 xAlign) {
+	assert(xAlign > 0);
+	_xAlign = xAlign;
+}
+
+void DirtyRectList::addRect(const Common::Rect &rect) {
+	if (_allDirty || !rect.isValidRect())
+		return;
+
+	Common::Rect r = rect;
+	r.clip(_bounds);
+	if (r.isEmpty())
+		return;
+
+	if (_xAlign > 1) {
+		r.left -= r.left % _xAlign;
+		r.right += (_xAlign - r.right % _xAlign) % _xAlign;
+		r.clip(_bounds);
+	}
+
+	// Swallow or merge with existing rectangles until nothing changes.
+	// Merging grows r, which may make it worth merging with rectangles
+	// that were checked before, hence the restart.
+	uint i = 0;
+	while (i < _rects.size()) {
+		const Common::Rect &e = _rects[i];
+
+		if (e.contains(r))
+			return;
+
+		if (r.contains(e)) {
+			_rects.remove_at(i);
+			continue;
+		}
+
+		// Merging is worthwhile when the bounding box wastes no more than
+		// the overlap we would otherwise present twice, plus a quarter of
+		// the area actually covered.
+		const Common::Rect overlap = r.findIntersectingRect(e);
+		const uint32 covered = area(r) + area(e) - area(overlap);
+		if (mergeWaste(r, e) <= area(overlap) + covered / 4) {
+			r.extend(e);
+			_rects.remove_at(i);
+			i = 0;
+			continue;
+		}
+
+		++i;
+	}
+
+	_rects.push_back(r);
+
+	while (_rects.size() > _maxRects)
+		mergeCheapestPair();
+
+	// Past this point presenting everything in one go is cheaper than
+	// handling many separate rectangles.
+	if (getDirtyArea() >= area(_bounds) / 4 * 3)
+		markAll();
+}
+
+void DirtyRectList::addRects(const DirtyRectList &other) {
+	if (other.isAllDirty()) {
+		markAll();
+		return;
+	}
+
+	for (uint i = 0; i < other._rects.size(); ++i)
+		addRect(other._rects[i]);
+}
+
+void DirtyRectList::markAll() {
+	_rects.clear();
+	if (!_bounds.isEmpty())
+		_rects.push_back(_bounds);
+	_allDirty = true;
+}
+
+void DirtyRectList::clear() {
+	_rects.clear();
+	_allDirty = false;
+}
+
+uint32 DirtyRectList::getDirtyArea() const {
+	uint32 total = 0;
+	for (uint i = 0; i < _rects.size(); ++i)
+		total += area(_rects[i]);
+	return total;
+}
+
+uint32 DirtyRectList::mergeWaste(const Common::Rect &a, const Common::Rect &b) {
+	Common::Rect u = a;
+	u.extend(b);
+
+	const uint32 covered = area(a) + area(b) - area(a.findIntersectingRect(b));
+	return area(u) - covered;
+}
+
+void DirtyRectList::mergeCheapestPair() {
+	assert(_rects.size() >= 2);
+
+	uint bestA = 0, bestB = 1;
+	uint32 bestWaste = mergeWaste(_rects[0], _rects[1]);
+
+	for (uint a = 0; a < _rects.size(); ++a) {
+		for (uint b = a + 1; b < _rects.size(); ++b) {
+			const uint32 waste = mergeWaste(_rects[a], _rects[b]);
+			if (waste < bestWaste) {
+				bestWaste = waste;
+				bestA = a;
+				bestB = b;
+			}
+		}
+	}
+
+	_rects[bestA].extend(_rects[bestB]);
+	_rects.remove_at(bestB);
+
+	// The grown rectangle may now contain others.
+	for (uint i = 0; i < _rects.size();) {
+		if (i != bestA && _rects[bestA].contains(_rects[i])) {
+			_rects.remove_at(i);
+			if (i < bestA)
+				--bestA;
+		} else {
+			++i;
+		}
+	}
+}
+
+void computeCopySpans(const Common::Array<Common::Rect> &rects, uint bytesPerPixel, uint srcPitch, uint dstPitch,
+					  Common::Array<CopySpan> &spans) {
+	for (uint i = 0; i < rects.size(); ++i) {
+		const Common::Rect &r = rects[i];
+		if (r.isEmpty())
+			continue;
+
+		const uint32 rowBytes = r.width() * bytesPerPixel;
+
+		CopySpan span;
+		span.srcOffset = r.top * srcPitch + r.left * bytesPerPixel;
+		span.dstOffset = r.top * dstPitch + r.left * bytesPerPixel;
+
+		if (rowBytes == srcPitch && rowBytes == dstPitch) {
+			span.length = rowBytes * r.height();
+			spans.push_back(span);
+			continue;
+		}
+
+		span.length = rowBytes;
+		for (int16 y = r.top; y < r.bottom; ++y) {
+			spans.push_back(span);
+			span.srcOffset += srcPitch;
+			span.dstOffset += dstPitch;
+		}
+	}
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,173 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTYRECTS_H
+#define GRAPHICS_DIRTYRECTS_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * Collects the areas of a surface that changed since they were last
+ * presented, and keeps them coalesced into a small number of rectangles.
+ *
+ * Rectangles are clipped to the bounds and may be widened to a horizontal
+ * alignment, which suits backends whose conversion works on groups of
+ * pixels (e.g. chunky-to-planar). Two rectangles are merged when their
+ * bounding box wastes little area; the returned rectangles may still overlap
+ * slightly, which is harmless for copy-type presents. When too much of the
+ * surface is dirty the list collapses to a single full-surface rectangle.
+ */
+class DirtyRectList {
+public:
+	DirtyRectList(uint maxRects = 16);
+
+	/**
+	 * Set the area rectangles are clipped against. Marks everything dirty.
+	 */
+	void setBounds(int16 width, int16 height);
+
+	/**
+	 * Round the left and right edge of every added rectangle to a multiple
+	 * of the given number of pixels.
+	 */
+	void setAlignment(uint16 xAlign);
+
+	/**
+	 * Add an area that changed. Empty and off-surface areas are ignored.
+	 */
+	void addRect(const Common::Rect &r);
+
+	/**
+	 * Add the same areas another list holds.
+	 */
+	void addRects(const DirtyRectList &other);
+
+	/**
+	 * Mark the whole surface as dirty.
+	 */
+	void markAll();
+
+	/**
+	 * Forget all dirty areas, usually after they have been presented.
+	 */
+	void clear();
+
+	bool empty() const { return _rects.empty(); }
+	bool isAllDirty() const { return _allDirty; }
+
+	/**
+	 * Return the current dirty rectangles. When everything is dirty this is
+	 * a single rectangle covering the bounds.
+	 */
+	const Common::Array<Common::Rect> &getRects() const { return _rects; }
+
+	/**
+	 * Return the number of pixels covered by the dirty rectangles,
+	 * counting overlaps twice.
+	 */
+	uint32 getDirtyArea() const;
+
+	const Common::Rect &getBounds() const { return _bounds; }
+
+private:
+	static uint32 area(const Common::Rect &r) { return (uint32)r.width() * r.height(); }
+
+	/**
+	 * Returns the number of pixels the bounding box of both rectangles
+	 * covers that neither of them does.
+	 */
+	static uint32 mergeWaste(const Common::Rect &a, const Common::Rect &b);
+
+	/**
+	 * Merge the two rectangles of the list that waste the least area
+	 * when combined.
+	 */
+	void mergeCheapestPair();
+
+	Common::Array<Common::Rect> _rects;
+	Common::Rect _bounds;
+	uint _maxRects;
+	uint16 _xAlign;
+	bool _allDirty;
+};
+
+/**
+ * Joins the blocks a block based decoder updates, in the order it updates
+ * them, into one rectangle per run of neighbouring blocks of a block row.
+ * Each run is added to the list once it ends, at the latest when the
+ * collector goes out of scope. Without a list, blocks are ignored so
+ * decoders can skip tracking cheaply when nobody asked for it.
+ */
+class DirtyBlockCollector {
+public:
+	DirtyBlockCollector(DirtyRectList *list) : _list(list) {}
+	~DirtyBlockCollector() { flush(); }
+
+	void addBlock(int16 x, int16 y, int16 width, int16 height) {
+		if (!_list)
+			return;
+
+		if (!_run.isEmpty() && x == _run.right && y == _run.top && y + height == _run.bottom) {
+			_run.right += width;
+			return;
+		}
+
+		flush();
+		_run = Common::Rect(x, y, x + width, y + height);
+	}
+
+	void flush() {
+		if (!_run.isEmpty()) {
+			_list->addRect(_run);
+			_run = Common::Rect();
+		}
+	}
+
+private:
+	DirtyRectList *_list;
+	Common::Rect _run;
+};
+
+/**
+ * A run of bytes to copy when transferring dirty areas between two buffers.
+ */
+struct CopySpan {
+	uint32 srcOffset;
+	uint32 dstOffset;
+	uint32 length;
+};
+
+/**
+ * Compute the byte spans to copy to transfer the given rectangles from a
+ * buffer with srcPitch to one with dstPitch. Rows of a rectangle that follow
+ * each other without a gap in both buffers are joined into a single span.
+ * The spans are appended to the given array.
+ */
+void computeCopySpans(const Common::Array<Common::Rect> &rects, uint bytesPerPixel, uint srcPitch, uint dstPitch,
+					  Common::Array<CopySpan> &spans);
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,198 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/drawcache.h"
+#include "graphics/surface.h"
+
+namespace Graphics {
+
+DrawCache::DrawCache(uint32 maxBytes) : _maxBytes(maxBytes), _size(0), _useCounter(0), _hits(0), _misses(0),
+	_pending(false), _pendingPixels(nullptr) {
+}
+
+DrawCache::~DrawCache() {
+	clear();
+}
+
+bool DrawCache::begin(uint32 id, const uint32 *state, uint stateSize, const Common::Rect &area, Surface &surface, const Common::Rect &rect) {
+	assert(stateSize <= kMaxStateSize);
+
+	free(_pendingPixels);
+	_pendingPixels = nullptr;
+	_pending = false;
+
+	Key key;
+	key.id = id;
+	memset(key.state, 0, sizeof(key.state));
+	memcpy(key.state, state, stateSize * sizeof(uint32));
+	key.width = area.width();
+	key.height = area.height();
+	key.rect = rect;
+	key.rect.translate(-area.left, -area.top);
+	key.bytesPerPixel = surface.format.bytesPerPixel;
+
+	const uint32 size = entrySize(key);
+	if (rect.isEmpty() || size > _maxBytes / 4) {
+		++_misses;
+		return false;
+	}
+
+	key.pixelHash = hashPixels(surface, rect);
+
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end()) {
+		if (!matches(surface, rect, i->_value.pixels)) {
+			// A different background with the same hash. Keep the stored
+			// result and draw this one the slow way.
+			++_misses;
+			return false;
+		}
+
+		const uint32 rowBytes = rect.width() * key.bytesPerPixel;
+		const byte *src = i->_value.pixels + size / 2;
+		for (int y = rect.top; y < rect.bottom; ++y) {
+			memcpy(surface.getBasePtr(rect.left, y), src, rowBytes);
+			src += rowBytes;
+		}
+
+		i->_value.lastUse = ++_useCounter;
+		++_hits;
+		return true;
+	}
+
+	_pendingPixels = (byte *)malloc(size);
+	if (!_pendingPixels) {
+		++_misses;
+		return false;
+	}
+
+	copyOut(surface, rect, _pendingPixels);
+	_pendingKey = key;
+	_pendingRect = rect;
+	_pending = true;
+	++_misses;
+	return false;
+}
+
+void DrawCache::end(const Surface &surface) {
+	if (!_pending)
+		return;
+
+	_pending = false;
+	if (surface.format.bytesPerPixel != _pendingKey.bytesPerPixel) {
+		free(_pendingPixels);
+		_pendingPixels = nullptr;
+		return;
+	}
+
+	const uint32 size = entrySize(_pendingKey);
+	copyOut(surface, _pendingRect, _pendingPixels + size / 2);
+
+	evict(size);
+
+	Entry entry;
+	entry.pixels = _pendingPixels;
+	entry.lastUse = ++_useCounter;
+	_entries[_pendingKey] = entry;
+	_size += size;
+
+	_pendingPixels = nullptr;
+}
+
+void DrawCache::clear() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		free(i->_value.pixels);
+	_entries.clear();
+	_size = 0;
+
+	free(_pendingPixels);
+	_pendingPixels = nullptr;
+	_pending = false;
+}
+
+uint32 DrawCache::hashPixels(const Surface &surface, const Common::Rect &rect) {
+	// FNV-1a over whole pixels rather than bytes, which is plenty to tell
+	// backgrounds apart and a lot cheaper on slow machines.
+	uint32 hash = 2166136261U;
+
+	for (int y = rect.top; y < rect.bottom; ++y) {
+		switch (surface.format.bytesPerPixel) {
+		case 2: {
+			const uint16 *p = (const uint16 *)surface.getBasePtr(rect.left, y);
+			for (int x = rect.width(); x > 0; --x)
+				hash = (hash ^ *p++) * 16777619U;
+			break;
+		}
+
+		case 4: {
+			const uint32 *p = (const uint32 *)surface.getBasePtr(rect.left, y);
+			for (int x = rect.width(); x > 0; --x)
+				hash = (hash ^ *p++) * 16777619U;
+			break;
+		}
+
+		default: {
+			const byte *p = (const byte *)surface.getBasePtr(rect.left, y);
+			for (int x = rect.width() * surface.format.bytesPerPixel; x > 0; --x)
+				hash = (hash ^ *p++) * 16777619U;
+			break;
+		}
+		}
+	}
+
+	return hash;
+}
+
+void DrawCache::copyOut(const Surface &surface, const Common::Rect &rect, byte *dst) const {
+	const uint32 rowBytes = rect.width() * surface.format.bytesPerPixel;
+	for (int y = rect.top; y < rect.bottom; ++y) {
+		memcpy(dst, surface.getBasePtr(rect.left, y), rowBytes);
+		dst += rowBytes;
+	}
+}
+
+bool DrawCache::matches(const Surface &surface, const Common::Rect &rect, const byte *src) const {
+	const uint32 rowBytes = rect.width() * surface.format.bytesPerPixel;
+	for (int y = rect.top; y < rect.bottom; ++y) {
+		if (memcmp(src, surface.getBasePtr(rect.left, y), rowBytes))
+			return false;
+		src += rowBytes;
+	}
+
+	return true;
+}
+
+void DrawCache::evict(uint32 neededBytes) {
+	while (!_entries.empty() && _size + neededBytes > _maxBytes) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+
+		_size -= entrySize(oldest->_key);
+		free(oldest->_value.pixels);
+		_entries.erase(oldest);
+	}
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,141 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_DRAWCACHE_H
+#define GRAPHICS_DRAWCACHE_H
+
+#include "common/hashmap.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+struct Surface;
+
+/**
+ * Remembers what drawing an element did to an area of a surface, so the
+ * same element can later be put on screen by copying pixels instead of
+ * rendering it again.
+ *
+ * Elements are identified by an id, a few state values (e.g. colors the
+ * drawing depends on) and the size of the area they are drawn into. Since
+ * drawing may blend with what is already on the surface (anti-aliased
+ * edges, shadows), a stored result is only reused when the pixels below the
+ * element are exactly the ones it was drawn on.
+ * The cache holds at most a given number of bytes and drops the least
+ * recently used results first.
+ *
+ * Usage:
+ * @code
+ * if (!cache.begin(id, state, stateSize, area, surface, rect)) {
+ *     // draw the element into area, touching nothing outside rect
+ *     cache.end(surface);
+ * }
+ * @endcode
+ */
+class DrawCache {
+public:
+	enum {
+		kMaxStateSize = 8
+	};
+
+	DrawCache(uint32 maxBytes);
+	~DrawCache();
+
+	/**
+	 * Look up the element drawn into area with the given state, which
+	 * changes the pixels within rect of the surface. If a matching result
+	 * is stored, it is copied to the surface and true is returned. Otherwise
+	 * the current pixels are remembered until end() is called and false is
+	 * returned.
+	 */
+	bool begin(uint32 id, const uint32 *state, uint stateSize, const Common::Rect &area, Surface &surface, const Common::Rect &rect);
+
+	/**
+	 * Store the result of drawing the element passed to the last begin()
+	 * call that returned false.
+	 */
+	void end(const Surface &surface);
+
+	/**
+	 * Drop all stored results, e.g. after the look of the elements changed.
+	 */
+	void clear();
+
+	uint32 getSize() const { return _size; }
+	uint getEntryCount() const { return _entries.size(); }
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+
+private:
+	struct Key {
+		uint32 id;
+		uint32 state[kMaxStateSize];
+		uint32 pixelHash;
+		int16 width, height;
+		Common::Rect rect; ///< Changed area, relative to the drawing area
+		byte bytesPerPixel;
+
+		bool operator==(const Key &other) const {
+			return id == other.id && !memcmp(state, other.state, sizeof(state)) && pixelHash == other.pixelHash &&
+			       width == other.width && height == other.height && rect == other.rect &&
+			       bytesPerPixel == other.bytesPerPixel;
+		}
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			uint hash = key.pixelHash ^ (key.id * 2654435761U) ^ ((uint)key.width << 16) ^ (uint)key.height;
+			for (uint i = 0; i < kMaxStateSize; ++i)
+				hash = hash * 31 + key.state[i];
+			return hash;
+		}
+	};
+
+	struct Entry {
+		byte *pixels; ///< The pixels before drawing, followed by those after
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	static uint32 hashPixels(const Surface &surface, const Common::Rect &rect);
+	static uint32 entrySize(const Key &key) { return 2 * key.rect.width() * key.rect.height() * key.bytesPerPixel; }
+
+	void copyOut(const Surface &surface, const Common::Rect &rect, byte *dst) const;
+	bool matches(const Surface &surface, const Common::Rect &rect, const byte *src) const;
+	void evict(uint32 neededBytes);
+
+	EntryMap _entries;
+	uint32 _maxBytes;
+	uint32 _size;
+	uint32 _useCounter;
+	uint32 _hits, _misses;
+
+	bool _pending;
+	Key _pendingKey;
+	Common::Rect _pendingRect;
+	byte *_pendingPixels;
+};
+
+} // End of namespace Graphics
+
+#endif
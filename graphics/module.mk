@@ -1,8 +1,11 @@
 MODULE := graphics
 
 MODULE_OBJS := \
+	c2p.o \
 	conversion.o \
 	cursorman.o \
+	dirtyrects.o \
+	drawcache.o \
 	font.o \
 	fontman.o \
 	fonts/bdf.o \
@@ -59,6 +59,17 @@ uint32 readTime(Common::ReadStream *inFile) {
 	return d;
 }
 
+// Wall clock time in microseconds, independent of the recorded timer.
+static uint64 getRealMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
 void writeTime(Common::WriteStream *outFile, uint32 d) {
 		//Simple RLE compression
 	if (d >= 0xff) {
@@ -89,6 +100,17 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 
+	_fastReplay = false;
+	_fastReplayFinished = false;
+	_replayedFrames = 0;
+	_replayStart = 0;
+	_frameStart = 0;
+	_frameEnd = 0;
+	_engineTime = 0;
+	_screenTime = 0;
+	_maxEngineTime = 0;
+	_maxScreenTime = 0;
+
 	DebugMan.addDebugChannel(kDebugLevelEventRec, "EventRec", "Event recorder debug level");
 }
 
@@ -100,6 +122,11 @@ void EventRecorder::deinit() {
 	if (!_initialized) {
 		return;
 	}
+	if (_fastReplay) {
+		finishFastReplay();
+		_fastReplay = false;
+		_fastPlayback = false;
+	}
 	setFileHeader();
 	_needRedraw = false;
 	_initialized = false;
@@ -150,6 +177,15 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_fakeTimer = _nextEvent.time;
 			_nextEvent = _playbackFile->getNextEvent();
 			_timerManager->handler();
+		} else if (_fastReplay && (_nextEvent.type == Common::EVENT_RETURN_TO_LAUNCHER || _nextEvent.type == Common::EVENT_INVALID)) {
+			// The recording is over. Let the game quit the normal way, with
+			// time passing as usual again while it does.
+			finishFastReplay();
+			_recordMode = kPassthrough;
+			_fastPlayback = false;
+			Common::Event quitEvent;
+			quitEvent.type = Common::EVENT_QUIT;
+			g_system->getEventManager()->pushEvent(quitEvent);
 		} else {
 			if (_nextEvent.type == Common::EVENT_RETURN_TO_LAUNCHER) {
 				error("playback:action=stopplayback");
@@ -259,7 +295,7 @@ Common::String EventRecorder::generateRecordFileName(const Common::String &targe
 }
 
 
-void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
+void EventRecorder::init(Common::String recordFileName, RecordMode mode, bool fastReplay) {
 	_fakeMixerManager = new NullSdlMixerManager();
 	_fakeMixerManager->init();
 	_fakeMixerManager->suspendAudio();
@@ -269,6 +305,18 @@ void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
 	_lastScreenshotTime = 0;
 	_recordMode = mode;
 	_needcontinueGame = false;
+	_fastReplay = fastReplay && (mode == kRecorderPlayback);
+	_fastPlayback = _fastReplay;
+	_fastReplayFinished = false;
+	_replayedFrames = 0;
+	_engineTime = 0;
+	_screenTime = 0;
+	_maxEngineTime = 0;
+	_maxScreenTime = 0;
+	_replayStart = _frameEnd = getRealMicros();
+	if (_fastReplay) {
+		ConfMan.setBool("disable_display", true, Common::ConfigManager::kTransientDomain);
+	}
 	if (ConfMan.hasKey("disable_display")) {
 		DebugMan.enableDebugChannel("EventRec");
 		gDebugLevel = 1;
@@ -550,6 +598,11 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_fastReplay) {
+		// Nobody gets to see the control panel, so only time the frame.
+		_frameStart = getRealMicros();
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -566,6 +619,25 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_fastReplay) {
+		if (_recordMode != kRecorderPlayback) {
+			return;
+		}
+		const uint32 engineTime = (uint32)(_frameStart - _frameEnd);
+		const uint32 screenTime = (uint32)(getRealMicros() - _frameStart);
+		// Everything before the first frame is engine startup.
+		if (_replayedFrames > 0) {
+			_engineTime += engineTime;
+			_maxEngineTime = MAX(_maxEngineTime, engineTime);
+		}
+		_screenTime += screenTime;
+		_maxScreenTime = MAX(_maxScreenTime, screenTime);
+		debugC(1, kDebugLevelEventRec, "playback:action=frame frame=%u time=%u engine=%u screen=%u", _replayedFrames, _fakeTimer, engineTime, screenTime);
+		++_replayedFrames;
+		// Leave the logging out of the next frame.
+		_frameEnd = getRealMicros();
+		return;
+	}
     if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -574,6 +646,33 @@ void EventRecorder::postDrawOverlayGui() {
 	}
 }
 
+void EventRecorder::finishFastReplay() {
+	if (_fastReplayFinished) {
+		return;
+	}
+	_fastReplayFinished = true;
+
+	Common::String screenMD5 = "none";
+	Graphics::Surface screen;
+	uint8 md5[16];
+	if (grabScreenAndComputeMD5(screen, md5)) {
+		screenMD5.clear();
+		for (int i = 0; i < 16; i++) {
+			screenMD5 += Common::String::format("%02x", md5[i]);
+		}
+		screen.free();
+	}
+
+	// All times are in microseconds, except for the replayed and real
+	// time taken, which are in milliseconds.
+	const uint32 frames = MAX<uint32>(_replayedFrames, 1);
+	const uint32 engineFrames = MAX<uint32>(_replayedFrames, 2) - 1;
+	debugC(1, kDebugLevelEventRec, "playback:action=\"Fast replay\" frames=%u time=%u realtime=%u engine=%u engineavg=%u enginemax=%u screen=%u screenavg=%u screenmax=%u screenmd5=%s",
+		_replayedFrames, _fakeTimer, (uint32)((getRealMicros() - _replayStart) / 1000),
+		(uint32)_engineTime, (uint32)(_engineTime / engineFrames), _maxEngineTime,
+		(uint32)_screenTime, (uint32)(_screenTime / frames), _maxScreenTime, screenMD5.c_str());
+}
+
 Common::StringArray EventRecorder::listSaveFiles(const Common::String &pattern) {
 	if (_recordMode == kRecorderPlayback) {
 		Common::StringArray result;
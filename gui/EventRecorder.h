@@ -77,7 +77,14 @@ public:
 		kRecorderPlaybackPause = 3	/**< kRecordetPlaybackPause, interal state when user pauses the playback */
 	};
 
-	void init(Common::String recordFileName, RecordMode mode);
+	/**
+	 * Start recording or playing back.
+	 *
+	 * @param fastReplay	for playback only: replay headless and as fast as
+	 *			possible, reporting how long every frame took and a
+	 *			hash of the final screen, then quit
+	 */
+	void init(Common::String recordFileName, RecordMode mode, bool fastReplay = false);
 	void deinit();
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
@@ -227,6 +234,19 @@ private:
 	Common::String _recordFileName;
 	bool _fastPlayback;
 	bool _needRedraw;
+
+	void finishFastReplay();
+
+	bool _fastReplay;
+	bool _fastReplayFinished;
+	uint32 _replayedFrames;
+	uint64 _replayStart;
+	uint64 _frameStart;
+	uint64 _frameEnd;
+	uint64 _engineTime;
+	uint64 _screenTime;
+	uint32 _maxEngineTime;
+	uint32 _maxScreenTime;
 };
 
 } // End of namespace GUI
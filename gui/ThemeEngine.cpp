@@ -24,11 +24,13 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/md5.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
 
 #include "graphics/cursorman.h"
+#include "graphics/drawcache.h"
 #include "graphics/fontman.h"
 #include "graphics/surface.h"
 #include "graphics/transparent_surface.h"
@@ -176,10 +178,11 @@ static const DrawDataInfo kDrawDataDefaults[] = {
 ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(nullptr), _vectorRenderer(nullptr),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
-	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
+	_font(nullptr), _overlayShowsBackBuffer(false), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
 	_cursor(nullptr) {
 
 	_system = g_system;
+	_drawCache = new Graphics::DrawCache(kDrawCacheSize);
 	_parser = new ThemeParser(this);
 	_themeEval = new GUI::ThemeEval();
 
@@ -226,6 +229,7 @@ ThemeEngine::~ThemeEngine() {
 	_backBuffer.free();
 
 	unloadTheme();
+	delete _drawCache;
 
 	// Release all graphics surfaces
 	for (ImagesMap::iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
@@ -355,6 +359,12 @@ void ThemeEngine::clearAll() {
 	if (_initOk) {
 		_system->clearOverlay();
 		_system->grabOverlay(_backBuffer.getPixels(), _backBuffer.pitch);
+
+		// The overlay now shows the whole backbuffer, so the screen has to
+		// catch up everywhere, but only what is drawn from here on has to
+		// be presented.
+		_screenChanges.markAll();
+		_overlayShowsBackBuffer = true;
 	}
 }
 
@@ -451,7 +461,12 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
 	// list. Clearing it avoids invalid overlay writes when the backend
 	// resizes the overlay.
+	_dirtyScreen.setBounds(width, height);
 	_dirtyScreen.clear();
+	_screenChanges.setBounds(width, height);
+
+	// Cached items were rendered for the old pixel format and renderer.
+	_drawCache->clear();
 }
 
 void WidgetDrawData::calcBackgroundOffset() {
@@ -705,10 +720,41 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 /**********************************************************
  * Theme XML loading
  *********************************************************/
+/**
+ * Check whether a binary STX file can be read and, if checkSource is set,
+ * was created from the given STX file. A binary file left over from before
+ * the STX file was edited would otherwise hide the changes.
+ */
+static bool isUsableBinarySTX(Common::SeekableReadStream &stream, const Common::ArchiveMember &source, bool checkSource) {
+	byte header[Common::XMLParser::kBinaryHeaderSize];
+	const bool complete = stream.read(header, sizeof(header)) == sizeof(header);
+	stream.seek(0);
+
+	if (!complete || READ_BE_UINT32(header) != MKTAG('B', 'X', 'M', 'L') ||
+			READ_LE_UINT16(header + 4) != Common::XMLParser::kBinaryVersion)
+		return false;
+
+	if (!checkSource)
+		return true;
+
+	Common::SeekableReadStream *sourceStream = source.createReadStream();
+	if (!sourceStream)
+		return false;
+
+	// Compare the cheap size first, so most edits never need the MD5
+	uint8 digest[16];
+	const bool matches = (uint32)sourceStream->size() == READ_LE_UINT32(header + 6) &&
+		Common::computeStreamMD5(*sourceStream, digest) && !memcmp(digest, header + 10, sizeof(digest));
+	delete sourceStream;
+
+	return matches;
+}
+
 void ThemeEngine::loadTheme(const Common::String &themeId) {
 	unloadTheme();
 
 	debug(6, "Loading theme %s", themeId.c_str());
+	const uint32 startTime = _system->getMillis();
 
 	if (themeId == "builtin") {
 		_themeOk = loadDefaultXML();
@@ -729,6 +775,8 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			_widgets[i]->calcBackgroundOffset();
 		}
 	}
+
+	debug(1, "Loaded theme %s in %d ms", themeId.c_str(), _system->getMillis() - startTime);
 }
 
 void ThemeEngine::unloadTheme() {
@@ -751,6 +799,7 @@ void ThemeEngine::unloadTheme() {
 	}
 
 	_themeEval->reset();
+	_drawCache->clear();
 	_themeOk = false;
 }
 
@@ -825,12 +874,30 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 	}
 
 	//
-	// Loop over all STX files, load and parse them
+	// Loop over all STX files, load and parse them. Prefer the binary
+	// version scummtheme.py stores next to them, which parses a lot faster.
+	// Theme archives are built with both at once, so only the files of
+	// unpacked themes, which may have been edited since, are compared.
 	//
+	const bool checkBinarySource = !_themeFile.matchString("*.zip", true);
+
 	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
 		assert((*i)->getName().hasSuffix(".stx"));
 
-		if (_parser->loadStream((*i)->createReadStream()) == false) {
+		const uint32 startTime = _system->getMillis();
+
+		Common::String binaryName = (*i)->getName();
+		binaryName.setChar('b', binaryName.size() - 1);
+		Common::SeekableReadStream *stream = _themeArchive->createReadStreamForMember(binaryName);
+		if (stream && !isUsableBinarySTX(*stream, **i, checkBinarySource)) {
+			delete stream;
+			stream = nullptr;
+		}
+
+		if (!stream)
+			stream = (*i)->createReadStream();
+
+		if (_parser->loadStream(stream) == false) {
 			warning("Failed to load STX file '%s'", (*i)->getDisplayName().c_str());
 			_parser->close();
 			return false;
@@ -842,6 +909,9 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 			return false;
 		}
 
+		debug(6, "Parsed %s%s in %d ms", (*i)->getDisplayName().c_str(), _parser->isBinary() ? " (binary)" : "",
+		      _system->getMillis() - startTime);
+
 		_parser->close();
 	}
 
@@ -886,9 +956,26 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		// Steps may leave colors unset and use the ones set before, so they
+		// are part of what identifies the result. So is the parity of the
+		// position, since gradients are dithered by absolute coordinates.
+		uint32 state[2 + Graphics::VectorRenderer::kColorStateSize];
+		state[0] = dynamic;
+		state[1] = (area.left & 1) | ((area.top & 1) << 1);
+		_vectorRenderer->getColorState(state + 2);
+
+		Graphics::TransparentSurface &surface = *_vectorRenderer->getActiveSurface();
 		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		if (_drawCache->begin(type, state, ARRAYSIZE(state), area, surface, extendedRect)) {
+			// Leave the colors as drawing the steps would have.
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->setStepColors(*step);
+			}
+		} else {
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+			}
+			_drawCache->end(surface);
 		}
 
 		addDirtyRect(extendedRect);
@@ -1342,7 +1429,21 @@ void ThemeEngine::debugWidgetPosition(const char *name, const Common::Rect &r) {
  * Screen/overlay management
  *********************************************************/
 void ThemeEngine::copyBackBufferToScreen() {
-	memcpy(_screen.getPixels(), _backBuffer.getPixels(), (size_t)(_screen.pitch * _screen.h));
+	const Common::Array<Common::Rect> &rects = _screenChanges.getRects();
+	for (uint i = 0; i < rects.size(); ++i) {
+		const Common::Rect &r = rects[i];
+		const uint rowBytes = r.width() * _screen.format.bytesPerPixel;
+		for (int y = r.top; y < r.bottom; ++y)
+			memcpy(_screen.getBasePtr(r.left, y), _backBuffer.getBasePtr(r.left, y), rowBytes);
+
+		// Unless the overlay already shows the backbuffer, what the screen
+		// showed there before has to be replaced.
+		if (!_overlayShowsBackBuffer)
+			_dirtyScreen.addRect(r);
+	}
+
+	_screenChanges.clear();
+	_overlayShowsBackBuffer = false;
 }
 
 void ThemeEngine::updateScreen() {
@@ -1363,36 +1464,23 @@ void ThemeEngine::addDirtyRect(Common::Rect r) {
 	if (r.isEmpty())
 		return;
 
-	// Check if the new rectangle is contained within another in the list
-	Common::List<Common::Rect>::iterator it;
-	for (it = _dirtyScreen.begin(); it != _dirtyScreen.end();) {
-		// If we find a rectangle which fully contains the new one,
-		// we can abort the search.
-		if (it->contains(r))
-			return;
-
-		// Conversely, if we find rectangles which are contained in
-		// the new one, we can remove them
-		if (r.contains(*it))
-			it = _dirtyScreen.erase(it);
-		else
-			++it;
-	}
-
-	// If we got here, we can safely add r to the list of dirty rects.
-	_dirtyScreen.push_back(r);
+	// Overlapping and neighbouring rectangles are merged, so each area is
+	// presented once.
+	_dirtyScreen.addRect(r);
+	_screenChanges.addRect(r);
 }
 
 void ThemeEngine::updateDirtyScreen() {
 	if (_dirtyScreen.empty())
 		return;
 
-	Common::List<Common::Rect>::iterator i;
-	for (i = _dirtyScreen.begin(); i != _dirtyScreen.end(); ++i) {
-		_vectorRenderer->copyFrame(_system, *i);
+	const Common::Array<Common::Rect> &rects = _dirtyScreen.getRects();
+	for (uint i = 0; i < rects.size(); ++i) {
+		_vectorRenderer->copyFrame(_system, rects[i]);
 	}
 
 	_dirtyScreen.clear();
+	_overlayShowsBackBuffer = false;
 }
 
 void ThemeEngine::applyScreenShading(ShadingStyle style) {
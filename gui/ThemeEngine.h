@@ -31,6 +31,7 @@
 #include "common/str.h"
 #include "common/rect.h"
 
+#include "graphics/dirtyrects.h"
 #include "graphics/surface.h"
 #include "graphics/transparent_surface.h"
 #include "graphics/font.h"
@@ -42,6 +43,7 @@
 class OSystem;
 
 namespace Graphics {
+class DrawCache;
 struct DrawStep;
 class VectorRenderer;
 }
@@ -286,6 +288,9 @@ public:
 	/** Constant value to expand dirty rectangles, to make sure they are fully copied */
 	static const int kDirtyRectangleThreshold = 1;
 
+	/** Number of bytes the rendered DrawData items may use at most */
+	static const uint32 kDrawCacheSize = 1024 * 1024;
+
 	struct Renderer {
 		const char *name;
 		const char *shortname;
@@ -731,7 +736,19 @@ protected:
 #endif
 
 	/** List of all the dirty screens that must be blitted to the overlay. */
-	Common::List<Common::Rect> _dirtyScreen;
+	Graphics::DirtyRectList _dirtyScreen;
+
+	/**
+	 * Areas where the screen may differ from the backbuffer, which are all
+	 * copyBackBufferToScreen() has to copy.
+	 */
+	Graphics::DirtyRectList _screenChanges;
+
+	/** Whether the overlay shows the backbuffer, right after clearAll(). */
+	bool _overlayShowsBackBuffer;
+
+	/** Rendered DrawData items, reused when the same item is drawn again. */
+	Graphics::DrawCache *_drawCache;
 
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
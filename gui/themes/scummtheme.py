@@ -3,10 +3,112 @@
 import sys
 import re
 import os
+import struct
+import hashlib
 import zipfile
 
 THEME_FILE_EXTENSIONS = ('.stx', '.bmp', '.fcc', '.ttf', '.png')
 
+# Binary form of the STX files read by Common::XMLParser, see common/xmlparser.h
+BXML_VERSION = 2
+BXML_END = 0
+BXML_KEY = 1
+BXML_CLOSED_KEY = 2
+BXML_KEY_END = 3
+
+NAME_CHARS = re.compile("[A-Za-z0-9_]+")
+
+# The text is passed as read from the STX file, which the header identifies
+# so the theme engine can ignore a binary file that is out of date.
+def compileSTX(source):
+	text = source.decode('latin-1')
+	strings = []
+	stringIds = {}
+	records = bytearray()
+
+	def stringId(s):
+		if s not in stringIds:
+			stringIds[s] = len(strings)
+			strings.append(s)
+		return struct.pack('<H', stringIds[s])
+
+	def skipSpaces(pos):
+		while pos < len(text) and text[pos].isspace():
+			pos += 1
+		return pos
+
+	def parseName(pos):
+		m = NAME_CHARS.match(text, pos)
+		if not m:
+			raise ValueError("Invalid name at offset %d" % pos)
+		return m.group(0), m.end()
+
+	keys = []
+	pos = skipSpaces(0)
+	while pos < len(text):
+		if text.startswith("<!--", pos):
+			pos = text.index("-->", pos) + 3
+		elif text.startswith("<?", pos):
+			pos = text.index("?>", pos) + 2
+		elif text.startswith("</", pos):
+			name, pos = parseName(pos + 2)
+			pos = skipSpaces(pos)
+			if not keys or keys.pop() != name or text[pos] != '>':
+				raise ValueError("Unexpected closure of '%s'" % name)
+			records.append(BXML_KEY_END)
+			pos += 1
+		elif text[pos] == '<':
+			name, pos = parseName(pos + 1)
+			values = []
+			while True:
+				pos = skipSpaces(pos)
+				if text.startswith("/>", pos):
+					closed = True
+					pos += 2
+					break
+				if text[pos] == '>':
+					closed = False
+					pos += 1
+					break
+				key, pos = parseName(pos)
+				pos = skipSpaces(pos)
+				if text[pos] != '=':
+					raise ValueError("Syntax error after '%s' in key '%s'" % (key, name))
+				pos = skipSpaces(pos + 1)
+				if text[pos] in "'\"":
+					end = text.index(text[pos], pos + 1)
+					value = text[pos + 1:end]
+					pos = end + 1
+				else:
+					value, pos = parseName(pos)
+				values.append((key, value))
+
+			if len(values) > 255:
+				raise ValueError("Too many properties in key '%s'" % name)
+
+			records.append(BXML_CLOSED_KEY if closed else BXML_KEY)
+			records += stringId(name)
+			records.append(len(values))
+			for key, value in values:
+				records += stringId(key) + stringId(value)
+			if not closed:
+				keys.append(name)
+		else:
+			raise ValueError("Expecting key start at offset %d" % pos)
+		pos = skipSpaces(pos)
+
+	if keys:
+		raise ValueError("Key '%s' is not closed" % keys[-1])
+	records.append(BXML_END)
+
+	data = bytearray(b'BXML')
+	data += struct.pack('<HI', BXML_VERSION, len(source)) + hashlib.md5(source).digest()
+	data += struct.pack('<H', len(strings))
+	for s in strings:
+		encoded = s.encode('latin-1')
+		data += struct.pack('<H', len(encoded)) + encoded
+	return bytes(data + records)
+
 def buildTheme(themeName):
 	if not os.path.isdir(themeName) or not os.path.isfile(os.path.join(themeName, "THEMERC")):
 		print ("Invalid theme name: " + themeName)
@@ -26,6 +128,14 @@ def buildTheme(themeName):
 			zf.write(filename, './' + filename)
 			print ("    Adding file: " + filename)
 
+			# Also store the STX file precompiled, which the theme engine
+			# loads instead when it is there.
+			if filename.endswith('.stx'):
+				with open(filename, 'rb') as stx_file:
+					source = stx_file.read()
+				zf.writestr(filename[:-4] + '.stb', compileSTX(source))
+				print ("    Adding file: " + filename[:-4] + '.stb')
+
 	os.chdir('../')
 
 	zf.close()
@@ -100,7 +210,7 @@ def printUsage():
 	print ("scummtheme.py makeall")
 	print ("    Builds all the available themes.\n")
 	print ("scummtheme.py make [themename]")
-	print ("    Builds the theme called 'themename'.\n")
+	print ("    Builds the theme called 'themename', adding a precompiled copy of each STX file.\n")
 	print ("scummtheme.py default [themename]")
 	print ("    Creates a 'default.inc' file to embed the given theme in the source code.\n")
 
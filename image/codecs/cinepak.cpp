@@ -296,10 +296,11 @@ struct CodebookConverterDitherQT {
 };
 
 template<typename PixelInt, typename CodebookConverter>
-void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *colorMap, Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
+void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *colorMap, Graphics::DirtyRectList *dirtyRegion, Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	uint32 flag = 0, mask = 0;
 	PixelInt *iy[4];
 	int32 startPos = stream.pos();
+	Graphics::DirtyBlockCollector dirtyBlocks(dirtyRegion);
 
 	for (uint16 y = frame.strips[strip].rect.top; y < frame.strips[strip].rect.bottom; y += 4) {
 		iy[0] = (PixelInt *)frame.surface->getBasePtr(frame.strips[strip].rect.left, + y);
@@ -332,6 +333,7 @@ void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *c
 					// Get the codebook
 					byte codebook = stream.readByte();
 					CodebookConverter::decodeBlock1(codebook, frame.strips[strip], iy, clipTable, colorMap, frame.surface->format);
+					dirtyBlocks.addBlock(x, y, 4, 4);
 				} else if (flag & mask) {
 					if ((stream.pos() - startPos + 4) > (int32)chunkSize)
 						return;
@@ -339,6 +341,7 @@ void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *c
 					byte codebook[4];
 					stream.read(codebook, 4);
 					CodebookConverter::decodeBlock4(codebook, frame.strips[strip], iy, clipTable, colorMap, frame.surface->format);
+					dirtyBlocks.addBlock(x, y, 4, 4);
 				}
 			}
 
@@ -357,6 +360,7 @@ CinepakDecoder::CinepakDecoder(int bitsPerPixel) : Codec(), _bitsPerPixel(bitsPe
 	_colorMap = 0;
 	_ditherPalette = 0;
 	_ditherType = kDitherTypeUnknown;
+	_trackDirtyRegion = false;
 
 	if (bitsPerPixel == 8) {
 		_pixelFormat = Graphics::PixelFormat::createFormatCLUT8();
@@ -424,9 +428,12 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 			stream.seek(-2, SEEK_CUR);
 	}
 
+	_dirtyRegion.clear();
+
 	if (!_curFrame.surface) {
 		_curFrame.surface = new Graphics::Surface();
 		_curFrame.surface->create(_curFrame.width, _curFrame.height, _pixelFormat);
+		_dirtyRegion.setBounds(_curFrame.width, _curFrame.height);
 	}
 
 	_y = 0;
@@ -617,11 +624,11 @@ void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 co
 
 void CinepakDecoder::decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	if (_curFrame.surface->format.bytesPerPixel == 1) {
-		decodeVectorsTmpl<byte, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<byte, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, _trackDirtyRegion ? &_dirtyRegion : 0, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 2) {
-		decodeVectorsTmpl<uint16, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint16, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, _trackDirtyRegion ? &_dirtyRegion : 0, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 4) {
-		decodeVectorsTmpl<uint32, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint32, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, _trackDirtyRegion ? &_dirtyRegion : 0, stream, strip, chunkID, chunkSize);
 	}
 }
 
@@ -690,9 +697,9 @@ byte CinepakDecoder::findNearestRGB(int index) const {
 
 void CinepakDecoder::ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	if (_ditherType == kDitherTypeVFW)
-		decodeVectorsTmpl<byte, CodebookConverterDitherVFW>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<byte, CodebookConverterDitherVFW>(_curFrame, _clipTable, _colorMap, _trackDirtyRegion ? &_dirtyRegion : 0, stream, strip, chunkID, chunkSize);
 	else
-		decodeVectorsTmpl<byte, CodebookConverterDitherQT>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<byte, CodebookConverterDitherQT>(_curFrame, _clipTable, _colorMap, _trackDirtyRegion ? &_dirtyRegion : 0, stream, strip, chunkID, chunkSize);
 }
 
 } // End of namespace Image
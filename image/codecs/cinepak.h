@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/rect.h"
+#include "graphics/dirtyrects.h"
 #include "graphics/pixelformat.h"
 
 #include "image/codecs/codec.h"
@@ -81,9 +82,13 @@ public:
 	bool hasDirtyPalette() const { return _dirtyPalette; }
 	bool canDither(DitherType type) const;
 	void setDither(DitherType type, const byte *palette);
+	void setTrackDirtyRegion(bool track) { _trackDirtyRegion = track; }
+	const Graphics::DirtyRectList *getDirtyRegion() const { return _trackDirtyRegion ? &_dirtyRegion : 0; }
 
 private:
 	CinepakFrame _curFrame;
+	Graphics::DirtyRectList _dirtyRegion;
+	bool _trackDirtyRegion;
 	int32 _y;
 	int _bitsPerPixel;
 	Graphics::PixelFormat _pixelFormat;
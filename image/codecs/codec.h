@@ -30,6 +30,10 @@ namespace Common {
 class SeekableReadStream;
 }
 
+namespace Graphics {
+class DirtyRectList;
+}
+
 namespace Image {
 
 /**
@@ -111,6 +115,19 @@ public:
 	 */
 	virtual void setDither(DitherType type, const byte *palette) {}
 
+	/**
+	 * Enable or disable tracking of the areas decodeFrame() changes. It is
+	 * off by default, as it costs time while decoding.
+	 */
+	virtual void setTrackDirtyRegion(bool track) {}
+
+	/**
+	 * Get the areas of the surface the last decodeFrame() call changed,
+	 * or 0 if the codec does not track them. Everything outside of them
+	 * still holds the frame decoded before.
+	 */
+	virtual const Graphics::DirtyRectList *getDirtyRegion() const { return 0; }
+
 	/**
 	 * Create a dither table, as used by QuickTime codecs.
 	 */
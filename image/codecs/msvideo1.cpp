@@ -40,6 +40,8 @@ MSVideo1Decoder::MSVideo1Decoder(uint16 width, uint16 height, byte bitsPerPixel)
                                                           Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0));
 
 	_bitsPerPixel = bitsPerPixel;
+	_dirtyRegion.setBounds(width, height);
+	_trackDirtyRegion = false;
 }
 
 MSVideo1Decoder::~MSVideo1Decoder() {
@@ -58,6 +60,7 @@ void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
     uint32 totalBlocks = blocks_wide * blocks_high;
     uint32 blockInc = 4;
     uint16 rowDec = stride + 4;
+    Graphics::DirtyBlockCollector dirtyBlocks(_trackDirtyRegion ? &_dirtyRegion : 0);
 
     for (uint16 block_y = blocks_high; block_y > 0; block_y--) {
         uint32 blockPtr = (block_y * 4 - 1) * stride;
@@ -120,6 +123,9 @@ void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
                 }
             }
 
+            if ((byte_b & 0xFC) != 0x84)
+                dirtyBlocks.addBlock((blocks_wide - block_x) * 4, (block_y - 1) * 4, 4, 4);
+
             blockPtr += blockInc;
             totalBlocks--;
         }
@@ -138,6 +144,7 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
     int32 total_blocks = blocks_wide * blocks_high;
     int32 block_inc = 4;
     int32 row_dec = stride + 4;
+    Graphics::DirtyBlockCollector dirtyBlocks(_trackDirtyRegion ? &_dirtyRegion : 0);
 
     for (int32 block_y = blocks_high; block_y > 0; block_y--) {
         int32 block_ptr = ((block_y * 4) - 1) * stride;
@@ -207,6 +214,9 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
                 }
             }
 
+            if ((byte_b & 0xFC) != 0x84)
+                dirtyBlocks.addBlock((blocks_wide - block_x) * 4, (block_y - 1) * 4, 4, 4);
+
             block_ptr += block_inc;
             total_blocks--;
         }
@@ -214,6 +224,8 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 }
 
 const Graphics::Surface *MSVideo1Decoder::decodeFrame(Common::SeekableReadStream &stream) {
+	_dirtyRegion.clear();
+
 	if (_bitsPerPixel == 8)
 		decode8(stream);
 	else
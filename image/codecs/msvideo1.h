@@ -23,6 +23,7 @@
 #ifndef IMAGE_CODECS_MSVIDEO1_H
 #define IMAGE_CODECS_MSVIDEO1_H
 
+#include "graphics/dirtyrects.h"
 #include "image/codecs/codec.h"
 
 namespace Image {
@@ -39,11 +40,15 @@ public:
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
 	Graphics::PixelFormat getPixelFormat() const { return _surface->format; }
+	void setTrackDirtyRegion(bool track) { _trackDirtyRegion = track; }
+	const Graphics::DirtyRectList *getDirtyRegion() const { return _trackDirtyRegion ? &_dirtyRegion : 0; }
 
 private:
 	byte _bitsPerPixel;
 
 	Graphics::Surface *_surface;
+	Graphics::DirtyRectList _dirtyRegion;
+	bool _trackDirtyRegion;
 
 	void decode8(Common::SeekableReadStream &stream);
 	void decode16(Common::SeekableReadStream &stream);
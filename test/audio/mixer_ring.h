@@ -0,0 +1,106 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_ring.h"
+
+class MixerRingBufferTestSuite : public CxxTest::TestSuite
+{
+	// Produces a running sample counter instead of mixing, so the order of
+	// the consumed samples can be checked.
+	class CountingRing : public Audio::MixerRingBuffer {
+	public:
+		CountingRing(uint blockSamples, uint numBlocks) : Audio::MixerRingBuffer(0, blockSamples, numBlocks), _next(0), _audible(-1) {}
+
+		int16 _next;
+		int _audible;
+
+	protected:
+		virtual int mixBlock(int16 *buf, uint samples) {
+			for (uint i = 0; i < samples; ++i) {
+				*buf++ = _next;
+				*buf++ = -_next;
+				++_next;
+			}
+			return _audible < 0 ? samples : _audible;
+		}
+	};
+
+	static bool isSequence(const int16 *buf, uint samples, int16 first) {
+		for (uint i = 0; i < samples; ++i)
+			if (buf[i * 2] != (int16)(first + i) || buf[i * 2 + 1] != (int16)-(first + i))
+				return false;
+		return true;
+	}
+
+	public:
+	void test_blocks_for_latency() {
+		TS_ASSERT_EQUALS(Audio::MixerRingBuffer::blocksForLatency(100, 22050, 512), (uint)5);
+		TS_ASSERT_EQUALS(Audio::MixerRingBuffer::blocksForLatency(1, 22050, 512), (uint)2);
+		TS_ASSERT_EQUALS(Audio::MixerRingBuffer::blocksForLatency(1000, 1024, 512), (uint)2);
+	}
+
+	void test_produce_until_full() {
+		CountingRing ring(16, 4);
+		TS_ASSERT_EQUALS(ring.getLatencySamples(), (uint)64);
+		TS_ASSERT_EQUALS(ring.produce(1), (uint)1);
+		TS_ASSERT_EQUALS(ring.produce(), (uint)3);
+		TS_ASSERT_EQUALS(ring.produce(), (uint)0);
+		TS_ASSERT_EQUALS(ring.getFilledBlocks(), (uint)4);
+		TS_ASSERT_EQUALS(ring.getBlocksMixed(), (uint32)4);
+	}
+
+	void test_consume_in_order() {
+		CountingRing ring(16, 4);
+		int16 buf[40 * 2];
+
+		ring.produce();
+
+		// Reads need not line up with blocks.
+		TS_ASSERT_EQUALS(ring.consume((byte *)buf, 10 * 4), 10);
+		TS_ASSERT(isSequence(buf, 10, 0));
+		TS_ASSERT_EQUALS(ring.getFilledBlocks(), (uint)4);
+
+		TS_ASSERT_EQUALS(ring.consume((byte *)buf, 30 * 4), 30);
+		TS_ASSERT(isSequence(buf, 30, 10));
+		TS_ASSERT_EQUALS(ring.getFilledBlocks(), (uint)2);
+
+		// Wrap around the end of the ring.
+		TS_ASSERT_EQUALS(ring.produce(), (uint)2);
+		TS_ASSERT_EQUALS(ring.consume((byte *)buf, 40 * 4), 40);
+		TS_ASSERT(isSequence(buf, 40, 40));
+		TS_ASSERT_EQUALS(ring.getUnderruns(), (uint32)0);
+	}
+
+	void test_underrun() {
+		CountingRing ring(16, 2);
+		int16 buf[40 * 2];
+
+		ring.produce(1);
+		memset(buf, 0x55, sizeof(buf));
+		TS_ASSERT_EQUALS(ring.consume((byte *)buf, 40 * 4), 16);
+		TS_ASSERT(isSequence(buf, 16, 0));
+		for (uint i = 16 * 2; i < 40 * 2; ++i)
+			TS_ASSERT_EQUALS(buf[i], 0);
+
+		TS_ASSERT_EQUALS(ring.getUnderruns(), (uint32)1);
+		TS_ASSERT_EQUALS(ring.getUnderrunSamples(), (uint32)24);
+
+		ring.reset();
+		TS_ASSERT_EQUALS(ring.getUnderruns(), (uint32)0);
+		TS_ASSERT_EQUALS(ring.getFilledBlocks(), (uint)0);
+	}
+
+	void test_audible_samples() {
+		CountingRing ring(16, 4);
+		int16 buf[64 * 2];
+
+		// Only the first 4 samples of each block hold sound.
+		ring._audible = 4;
+		ring.produce();
+		TS_ASSERT_EQUALS(ring.consume((byte *)buf, 2 * 4), 2);
+		TS_ASSERT_EQUALS(ring.consume((byte *)buf, 20 * 4), 2 + 4);
+
+		ring._audible = 0;
+		ring.produce();
+		TS_ASSERT_EQUALS(ring.consume((byte *)buf, 42 * 4), 4 + 4);
+	}
+};
@@ -0,0 +1,64 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "helper.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+	// Runs a fast path converter and the generic one over the same stream,
+	// in chunks that do not line up with their internal buffers.
+	void compare(int inRate, int outRate, bool stereo, bool reverseStereo, Audio::st_volume_t volL, Audio::st_volume_t volR, int tolerance) {
+		Audio::AudioStream *fastStream = createSineStream<int16>(inRate, 1, 0, false, stereo);
+		Audio::AudioStream *genericStream = createSineStream<int16>(inRate, 1, 0, false, stereo);
+
+		Audio::RateConverter *fast = Audio::makeRateConverter(inRate, outRate, stereo, reverseStereo);
+		Audio::RateConverter *generic = Audio::makeRateConverter(inRate, outRate, stereo, reverseStereo, false);
+
+		const int chunk = 333;
+		int16 fastBuf[chunk * 2], genericBuf[chunk * 2];
+		int total = 0;
+
+		for (;;) {
+			memset(fastBuf, 0, sizeof(fastBuf));
+			memset(genericBuf, 0, sizeof(genericBuf));
+
+			const int fastLen = fast->flow(*fastStream, fastBuf, chunk, volL, volR);
+			const int genericLen = generic->flow(*genericStream, genericBuf, chunk, volL, volR);
+			TS_ASSERT_EQUALS(fastLen, genericLen);
+
+			for (int i = 0; i < fastLen * 2; ++i)
+				TS_ASSERT_LESS_THAN_EQUALS(ABS(fastBuf[i] - genericBuf[i]), tolerance);
+
+			total += fastLen;
+			if (fastLen < chunk)
+				break;
+		}
+
+		TS_ASSERT_EQUALS(total, outRate);
+
+		delete fast;
+		delete generic;
+		delete fastStream;
+		delete genericStream;
+	}
+
+	public:
+	void test_upsample_by_two() {
+		compare(11025, 22050, false, false, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume, 0);
+		compare(22050, 44100, true, false, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume, 0);
+		compare(22050, 44100, true, true, 100, 200, 1);
+	}
+
+	void test_upsample_by_four() {
+		compare(11025, 44100, false, false, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume, 0);
+		compare(11025, 44100, true, false, 37, Audio::Mixer::kMaxMixerVolume, 1);
+		compare(11025, 44100, true, true, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume, 0);
+	}
+
+	void test_copy_unity_gain() {
+		compare(22050, 22050, true, true, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume, 0);
+		compare(22050, 22050, false, false, 128, 128, 0);
+	}
+};
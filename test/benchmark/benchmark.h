@@ -0,0 +1,53 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TEST_BENCHMARK_BENCHMARK_H
+#define TEST_BENCHMARK_BENCHMARK_H
+
+#include "common/scummsys.h"
+
+namespace Benchmark {
+
+/**
+ * Return a monotonic time stamp in microseconds.
+ */
+uint64 getMicros();
+
+/**
+ * Install a minimal g_system, for benchmarks of code that needs timing or
+ * mutexes. It does not draw, play or handle events.
+ */
+void initSystem();
+
+/**
+ * Entry points of the individual benchmarks. They get the arguments
+ * following the benchmark name and return the process exit code.
+ */
+int runC2P(int argc, const char *const *argv);
+int runRate(int argc, const char *const *argv);
+int runMixer(int argc, const char *const *argv);
+int runVideo(int argc, const char *const *argv);
+int runCinepak(int argc, const char *const *argv);
+
+} // End of namespace Benchmark
+
+#endif
@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/benchmark/benchmark.h"
+#include "graphics/c2p.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace Benchmark {
+
+namespace {
+
+const int kWidth = 320;
+const int kHeight = 256;
+
+// Draws a 32x32 "sprite" that moves across the screen, so delta mode has
+// something realistic to skip.
+void animate(Graphics::Surface &s, int frame) {
+	const int x = (frame * 3) % (kWidth - 32);
+	const int y = (frame * 2) % (kHeight - 32);
+
+	for (int row = 0; row < 32; ++row)
+		memset(s.getBasePtr(x, y + row), frame & 0xff, 32);
+}
+
+void run(const char *name, Graphics::C2PMethod method, bool delta, int frames, Graphics::PlanarBitmap &dst) {
+	Graphics::Surface chunky;
+	chunky.create(kWidth, kHeight, Graphics::PixelFormat::createFormatCLUT8());
+
+	uint32 seed = 1;
+	for (int i = 0; i < kWidth * kHeight; ++i) {
+		seed = seed * 1103515245 + 12345;
+		((byte *)chunky.getPixels())[i] = seed >> 16;
+	}
+
+	Graphics::ChunkyToPlanar c2p(method);
+	c2p.setDeltaMode(delta);
+
+	const uint64 start = getMicros();
+	for (int f = 0; f < frames; ++f) {
+		animate(chunky, f);
+		c2p.convert(chunky, dst);
+	}
+	const uint64 elapsed = MAX<uint64>(getMicros() - start, 1);
+
+	const double pixels = (double)kWidth * kHeight * frames;
+	const uint32 total = c2p.getGroupsWritten() + c2p.getGroupsSkipped();
+	printf("%-10s %10.2f Mpixels/s %8.1f frames/s  words written %9u  skipped %9u (%.1f%%)\n",
+		   name, pixels / elapsed, frames * 1000000.0 / elapsed,
+		   c2p.getGroupsWritten(), c2p.getGroupsSkipped(),
+		   total ? 100.0 * c2p.getGroupsSkipped() / total : 0.0);
+
+	chunky.free();
+}
+
+} // End of anonymous namespace
+
+int runC2P(int argc, const char *const *argv) {
+	const int frames = argc > 0 ? atoi(argv[0]) : 500;
+	if (frames <= 0) {
+		printf("Invalid frame count\n");
+		return 1;
+	}
+
+	Graphics::PlanarBitmap dst;
+	dst.bytesPerRow = kWidth / 8;
+	dst.rows = kHeight;
+	dst.depth = 8;
+	for (int i = 0; i < 8; ++i)
+		dst.planes[i] = new byte[dst.bytesPerRow * dst.rows];
+
+	printf("Converting %d frames of %dx%d pixels\n", frames, kWidth, kHeight);
+	run("reference", Graphics::kC2PReference, false, frames, dst);
+	run("merge", Graphics::kC2PMerge, false, frames, dst);
+	run("delta", Graphics::kC2PMerge, true, frames, dst);
+
+	for (int i = 0; i < 8; ++i)
+		delete[] dst.planes[i];
+
+	return 0;
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,237 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/benchmark/benchmark.h"
+#include "common/array.h"
+#include "common/memstream.h"
+#include "graphics/dirtyrects.h"
+#include "image/codecs/cinepak.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace Benchmark {
+
+namespace {
+
+const int kStripHeight = 48;
+
+/**
+ * Writes Cinepak frames the way the decoder reads them, for an 8bpp
+ * decoder. The update flags of inter frames are read whenever the
+ * previous 32 ran out, so they are reserved in the output at that point
+ * and filled in as the blocks are written.
+ */
+class FrameWriter {
+public:
+	FrameWriter(Common::Array<byte> &out) : _out(out), _flagPos(0), _mask(0) {}
+
+	void writeByte(byte b) { _out.push_back(b); }
+	void writeUint16(uint16 v) { writeByte(v >> 8); writeByte(v & 0xff); }
+	void writeUint24(uint32 v) { writeByte(v >> 16); writeUint16(v & 0xffff); }
+
+	void putUint24(uint32 pos, uint32 v) {
+		_out[pos] = v >> 16;
+		_out[pos + 1] = (v >> 8) & 0xff;
+		_out[pos + 2] = v & 0xff;
+	}
+
+	void putUint16(uint32 pos, uint16 v) {
+		_out[pos] = v >> 8;
+		_out[pos + 1] = v & 0xff;
+	}
+
+	void resetFlags() { _mask = 0; }
+
+	void writeFlag(bool set) {
+		_mask >>= 1;
+		if (!_mask) {
+			_flagPos = _out.size();
+			for (int i = 0; i < 4; ++i)
+				writeByte(0);
+			_mask = 0x80000000;
+		}
+
+		if (set) {
+			for (int i = 0; i < 4; ++i)
+				_out[_flagPos + i] |= (_mask >> (24 - i * 8)) & 0xff;
+		}
+	}
+
+	uint32 size() const { return _out.size(); }
+
+private:
+	Common::Array<byte> &_out;
+	uint32 _flagPos;
+	uint32 _mask;
+};
+
+uint32 nextRandom(uint32 &seed) {
+	seed = seed * 1103515245 + 12345;
+	return seed >> 16;
+}
+
+struct Sprite {
+	int x, y, w, h;
+};
+
+/**
+ * Builds a key frame followed by inter frames in which a few moving
+ * "sprites" and some scattered blocks change, like a typical cutscene.
+ */
+void createFrames(int frames, int width, int height, Common::Array<Common::Array<byte> > &out) {
+	const int blocksWide = width / 4;
+	uint32 seed = 1;
+
+	Sprite sprites[6];
+	for (int i = 0; i < 6; ++i) {
+		sprites[i].w = 8 + nextRandom(seed) % 16;
+		sprites[i].h = 8 + nextRandom(seed) % 16;
+		sprites[i].x = nextRandom(seed) % MAX(blocksWide - sprites[i].w, 1);
+		sprites[i].y = nextRandom(seed) % MAX(height / 4 - sprites[i].h, 1);
+	}
+
+	out.resize(frames);
+	for (int f = 0; f < frames; ++f) {
+		Common::Array<byte> &data = out[f];
+		FrameWriter w(data);
+		const bool key = (f == 0);
+		const int stripCount = (height + kStripHeight - 1) / kStripHeight;
+
+		// Later strips take over the codebooks of the first
+		w.writeByte(0);
+		w.writeUint24(0);
+		w.writeUint16(width);
+		w.writeUint16(height);
+		w.writeUint16(stripCount);
+
+		for (int strip = 0; strip < stripCount; ++strip) {
+			const int top = strip * kStripHeight;
+			const int stripHeight = MIN(kStripHeight, height - top);
+			const uint32 stripStart = w.size();
+
+			w.writeUint16(key ? 0x1000 : 0x1100);
+			w.writeUint16(0);
+			w.writeUint16(0);
+			w.writeUint16(0);
+			w.writeUint16(stripHeight);
+			w.writeUint16(width);
+
+			if (key && strip == 0) {
+				// Full greyscale V1 and V4 codebooks
+				for (byte id = 0x24; id <= 0x26; id += 2) {
+					w.writeByte(id);
+					w.writeUint24(4 + 256 * 4);
+					for (int i = 0; i < 256 * 4; ++i)
+						w.writeByte(nextRandom(seed));
+				}
+			}
+
+			const uint32 chunkStart = w.size();
+			w.writeByte(key ? 0x32 : 0x31);
+			w.writeUint24(0);
+			w.resetFlags();
+
+			for (int by = top / 4; by < (top + stripHeight) / 4; ++by) {
+				for (int bx = 0; bx < blocksWide; ++bx) {
+					if (key) {
+						w.writeByte(nextRandom(seed));
+						continue;
+					}
+
+					bool update = nextRandom(seed) % 200 == 0;
+					for (int i = 0; i < 6 && !update; ++i)
+						update = bx >= sprites[i].x && bx < sprites[i].x + sprites[i].w &&
+								 by >= sprites[i].y && by < sprites[i].y + sprites[i].h;
+
+					w.writeFlag(update);
+					if (!update)
+						continue;
+
+					const bool v4 = nextRandom(seed) & 1;
+					w.writeFlag(v4);
+					for (int i = 0; i < (v4 ? 4 : 1); ++i)
+						w.writeByte(nextRandom(seed));
+				}
+			}
+
+			w.putUint24(chunkStart + 1, w.size() - chunkStart);
+			w.putUint16(stripStart + 2, w.size() - stripStart);
+		}
+
+		w.putUint24(1, w.size());
+
+		for (int i = 0; i < 6; ++i) {
+			sprites[i].x = (sprites[i].x + 1) % MAX(blocksWide - sprites[i].w, 1);
+			sprites[i].y = (sprites[i].y + (f & 1)) % MAX(height / 4 - sprites[i].h, 1);
+		}
+	}
+}
+
+void run(const char *name, bool track, const Common::Array<Common::Array<byte> > &frames) {
+	Image::CinepakDecoder decoder(8);
+	decoder.setTrackDirtyRegion(track);
+
+	uint32 rects = 0;
+	const uint64 start = getMicros();
+	for (uint f = 0; f < frames.size(); ++f) {
+		Common::MemoryReadStream stream(frames[f].begin(), frames[f].size());
+		decoder.decodeFrame(stream);
+
+		const Graphics::DirtyRectList *dirtyRegion = decoder.getDirtyRegion();
+		if (dirtyRegion)
+			rects += dirtyRegion->getRects().size();
+	}
+	const uint64 elapsed = MAX<uint64>(getMicros() - start, 1);
+
+	printf("%-10s %8.1f frames/s %8.1f us/frame", name, frames.size() * 1000000.0 / elapsed, (double)elapsed / frames.size());
+	if (track)
+		printf("  %.1f rects/frame", (double)rects / frames.size());
+	printf("\n");
+}
+
+} // End of anonymous namespace
+
+int runCinepak(int argc, const char *const *argv) {
+	const int frames = argc > 0 ? atoi(argv[0]) : 1000;
+	const int width = argc > 1 ? atoi(argv[1]) : 320;
+	const int height = argc > 2 ? atoi(argv[2]) : 240;
+	if (frames <= 0 || width <= 0 || height <= 0 || (width % 4) || (height % 4) || width > 4096) {
+		printf("Expected: [frames] [width] [height], with the size a multiple of 4\n");
+		return 1;
+	}
+
+	initSystem();
+
+	Common::Array<Common::Array<byte> > data;
+	createFrames(frames, width, height, data);
+
+	printf("Decoding %d frames of %dx%d pixels\n", frames, width, height);
+	run("untracked", false, data);
+	run("tracked", true, data);
+
+	return 0;
+}
+
+} // End of namespace Benchmark
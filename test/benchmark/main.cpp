@@ -0,0 +1,76 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Benchmarks run headless on the build host, so plain C library calls are fine.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/benchmark/benchmark.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+namespace Benchmark {
+
+uint64 getMicros() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+struct Entry {
+	const char *name;
+	const char *description;
+	int (*run)(int argc, const char *const *argv);
+};
+
+static const Entry s_benchmarks[] = {
+	{ "c2p", "Chunky to planar conversion [frames]", runC2P },
+	{ "rate", "Audio rate converters [seconds]", runRate },
+	{ "mixer", "Audio mixer with synthetic streams [channels] [seconds] [output rate]", runMixer },
+	{ "video", "Decode a video file <file> [decoder|auto] [565|555|8888]", runVideo },
+	{ "cinepak", "Synthetic Cinepak frames with and without dirty regions [frames] [width] [height]", runCinepak },
+	{ nullptr, nullptr, nullptr }
+};
+
+} // End of namespace Benchmark
+
+static void usage(const char *name) {
+	printf("Usage: %s <benchmark> [arguments]\n\nBenchmarks:\n", name);
+	for (const Benchmark::Entry *e = Benchmark::s_benchmarks; e->name; ++e)
+		printf("  %-12s %s\n", e->name, e->description);
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	for (const Benchmark::Entry *e = Benchmark::s_benchmarks; e->name; ++e) {
+		if (!strcmp(argv[1], e->name))
+			return e->run(argc - 2, argv + 2);
+	}
+
+	usage(argv[0]);
+	return 1;
+}
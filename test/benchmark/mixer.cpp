@@ -0,0 +1,150 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/benchmark/benchmark.h"
+#include "audio/audiostream.h"
+#include "audio/mixer_intern.h"
+#include "audio/decoders/adpcm.h"
+#include "audio/decoders/raw.h"
+#include "common/memstream.h"
+#include "common/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace Benchmark {
+
+namespace {
+
+const int kBufferSamples = 1024;
+
+enum StreamKind {
+	kRaw8Mono11k,
+	kRaw16Stereo22k,
+	kADPCMMono22k,
+	kLoopingMono8k,
+	kStreamKindCount
+};
+
+const char *const s_kindNames[] = {
+	"raw 8-bit mono 11025",
+	"raw 16-bit stereo 22050",
+	"adpcm mono 22050",
+	"looping 16-bit 8000",
+	"mixed"
+};
+
+// A deterministic, noisy waveform so every run mixes the same data.
+byte *createData(uint32 size, uint32 seed) {
+	byte *data = (byte *)malloc(size);
+	for (uint32 i = 0; i < size; ++i) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = (byte)((i * 7) ^ (seed >> 24));
+	}
+	return data;
+}
+
+Audio::AudioStream *createStream(StreamKind kind, int seconds, uint32 seed) {
+	switch (kind) {
+	case kRaw8Mono11k: {
+		const uint32 size = 11025 * seconds;
+		return Audio::makeRawStream(createData(size, seed), size, 11025, Audio::FLAG_UNSIGNED);
+	}
+
+	case kRaw16Stereo22k: {
+		const uint32 size = 22050 * 4 * seconds;
+		return Audio::makeRawStream(createData(size, seed), size, 22050, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | Audio::FLAG_STEREO);
+	}
+
+	case kADPCMMono22k: {
+		const uint32 size = 22050 / 2 * seconds;
+		Common::SeekableReadStream *data = new Common::MemoryReadStream(createData(size, seed), size, DisposeAfterUse::YES);
+		return Audio::makeADPCMStream(data, DisposeAfterUse::YES, size, Audio::kADPCMDVI, 22050, 1);
+	}
+
+	case kLoopingMono8k: {
+		const uint32 size = 8000 * 2 / 4;
+		Audio::SeekableAudioStream *loop = Audio::makeRawStream(createData(size, seed), size, 8000, Audio::FLAG_16BITS);
+		return Audio::makeLoopingAudioStream(loop, 0);
+	}
+
+	default:
+		return nullptr;
+	}
+}
+
+void run(int kind, int channels, int seconds, uint outputRate) {
+	Audio::MixerImpl mixer(outputRate);
+	mixer.setReady(true);
+
+	for (int i = 0; i < channels; ++i) {
+		const StreamKind streamKind = kind == kStreamKindCount ? (StreamKind)(i % kStreamKindCount) : (StreamKind)kind;
+		mixer.playStream(Audio::Mixer::kPlainSoundType, nullptr, createStream(streamKind, seconds + 1, i + 1),
+						 -1, Audio::Mixer::kMaxChannelVolume - i * 8, (i * 37) % 255 - 127,
+						 DisposeAfterUse::YES, false, false);
+	}
+
+	int16 buffer[kBufferSamples * 2];
+	const uint32 total = outputRate * seconds;
+	uint32 done = 0;
+
+	// FNV-1a over the output, to spot changes in what gets mixed.
+	uint32 checksum = 2166136261u;
+
+	const uint64 start = getMicros();
+	while (done < total) {
+		mixer.mixCallback((byte *)buffer, sizeof(buffer));
+		for (int i = 0; i < kBufferSamples * 2; ++i)
+			checksum = (checksum ^ (uint16)buffer[i]) * 16777619u;
+		done += kBufferSamples;
+	}
+	const uint64 elapsed = MAX<uint64>(getMicros() - start, 1);
+
+	printf("%-24s %10.2f Msamples/s %8.1fx realtime %8.1f us/channel-second  checksum %08x\n",
+		   s_kindNames[kind], (double)done / elapsed, (double)done / outputRate * 1000000.0 / elapsed,
+		   (double)elapsed / channels / seconds, checksum);
+}
+
+} // End of anonymous namespace
+
+int runMixer(int argc, const char *const *argv) {
+	const int channels = argc > 0 ? atoi(argv[0]) : 8;
+	const int seconds = argc > 1 ? atoi(argv[1]) : 30;
+	const int outputRate = argc > 2 ? atoi(argv[2]) : 22050;
+	if (channels <= 0 || channels > 16 || seconds <= 0 || outputRate <= 0) {
+		printf("Expected 1-16 channels, a positive length and output rate\n");
+		return 1;
+	}
+
+	initSystem();
+
+	printf("Mixing %d channels for %d seconds at %d Hz\n", channels, seconds, outputRate);
+	for (int kind = 0; kind <= kStreamKindCount; ++kind)
+		run(kind, channels, seconds, outputRate);
+
+	return 0;
+}
+
+} // End of namespace Benchmark
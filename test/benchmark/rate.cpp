@@ -0,0 +1,117 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/benchmark/benchmark.h"
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "common/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace Benchmark {
+
+namespace {
+
+const int kOutputSamples = 1024;
+
+// An endless sawtooth, cheap enough not to distort the measurement.
+class SawtoothStream : public Audio::AudioStream {
+public:
+	SawtoothStream(int rate, bool stereo) : _rate(rate), _stereo(stereo), _value(0) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) {
+		for (int i = 0; i < numSamples; ++i) {
+			buffer[i] = _value;
+			_value += 97;
+		}
+		return numSamples;
+	}
+
+	bool isStereo() const { return _stereo; }
+	int getRate() const { return _rate; }
+	bool endOfData() const { return false; }
+
+private:
+	const int _rate;
+	const bool _stereo;
+	int16 _value;
+};
+
+void run(int inRate, int outRate, bool stereo, bool fastPaths, Audio::st_volume_t volume, int seconds) {
+	SawtoothStream stream(inRate, stereo);
+	Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, stereo, false, fastPaths);
+
+	int16 buffer[kOutputSamples * 2];
+	memset(buffer, 0, sizeof(buffer));
+
+	const uint64 total = (uint64)outRate * seconds;
+	uint64 done = 0;
+
+	const uint64 start = getMicros();
+	while (done < total)
+		done += converter->flow(stream, buffer, kOutputSamples, volume, volume);
+	const uint64 elapsed = MAX<uint64>(getMicros() - start, 1);
+
+	printf("%5d -> %5d %-6s %-7s vol %3d %10.2f Msamples/s %8.1fx realtime\n",
+		   inRate, outRate, stereo ? "stereo" : "mono", fastPaths ? "auto" : "generic", volume,
+		   (double)done / elapsed, (double)done / outRate * 1000000.0 / elapsed);
+
+	delete converter;
+}
+
+} // End of anonymous namespace
+
+int runRate(int argc, const char *const *argv) {
+	const int seconds = argc > 0 ? atoi(argv[0]) : 60;
+	if (seconds <= 0) {
+		printf("Invalid length\n");
+		return 1;
+	}
+
+	static const int rates[][2] = {
+		{ 11025, 22050 },
+		{ 22050, 44100 },
+		{ 11025, 44100 },
+		{ 22050, 22050 },
+		{ 44100, 22050 },
+		{ 22050, 48000 }
+	};
+
+	printf("Converting %d seconds of audio per case\n", seconds);
+	for (uint i = 0; i < ARRAYSIZE(rates); ++i) {
+		for (int stereo = 0; stereo < 2; ++stereo) {
+			for (int fast = 1; fast >= 0; --fast) {
+				run(rates[i][0], rates[i][1], stereo, fast, Audio::Mixer::kMaxMixerVolume, seconds);
+				run(rates[i][0], rates[i][1], stereo, fast, 192, seconds);
+			}
+		}
+	}
+
+	return 0;
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/benchmark/benchmark.h"
+#include "common/list.h"
+#include "common/system.h"
+#include "graphics/pixelformat.h"
+
+#include <stdio.h>
+#include <time.h>
+
+namespace Benchmark {
+
+namespace {
+
+/**
+ * Just enough of an OSystem for subsystems that need timing or mutexes,
+ * like Audio::MixerImpl. There is only one thread, so mutexes do nothing.
+ */
+class NullSystem : public OSystem {
+public:
+	NullSystem() : _start(getMicros()) {}
+
+	virtual Graphics::PixelFormat getScreenFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	virtual Common::List<Graphics::PixelFormat> getSupportedFormats() const { return Common::List<Graphics::PixelFormat>(); }
+	virtual void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	virtual int16 getHeight() { return 0; }
+	virtual int16 getWidth() { return 0; }
+	virtual PaletteManager *getPaletteManager() { return nullptr; }
+	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual Graphics::Surface *lockScreen() { return nullptr; }
+	virtual void unlockScreen() {}
+	virtual void fillScreen(uint32 col) {}
+	virtual void updateScreen() {}
+	virtual void setShakePos(int shakeXOffset, int shakeYOffset) {}
+	virtual void showOverlay() {}
+	virtual void hideOverlay() {}
+	virtual Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	virtual void clearOverlay() {}
+	virtual void grabOverlay(void *buf, int pitch) {}
+	virtual void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual int16 getOverlayHeight() { return 0; }
+	virtual int16 getOverlayWidth() { return 0; }
+	virtual bool showMouse(bool visible) { return false; }
+	virtual void warpMouse(int x, int y) {}
+	virtual void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) {}
+
+	virtual uint32 getMillis(bool skipRecord) { return (uint32)((getMicros() - _start) / 1000); }
+	virtual void delayMillis(uint msecs) {}
+	virtual void getTimeAndDate(TimeDate &t) const {
+		time_t now = time(nullptr);
+		struct tm *tm = localtime(&now);
+		t.tm_sec = tm->tm_sec;
+		t.tm_min = tm->tm_min;
+		t.tm_hour = tm->tm_hour;
+		t.tm_mday = tm->tm_mday;
+		t.tm_mon = tm->tm_mon;
+		t.tm_year = tm->tm_year;
+		t.tm_wday = tm->tm_wday;
+	}
+
+	virtual MutexRef createMutex() { return (MutexRef)this; }
+	virtual void lockMutex(MutexRef mutex) {}
+	virtual void unlockMutex(MutexRef mutex) {}
+	virtual void deleteMutex(MutexRef mutex) {}
+
+	virtual Audio::Mixer *getMixer() { return nullptr; }
+	virtual void quit() {}
+	virtual void displayMessageOnOSD(const char *msg) {}
+	virtual void displayActivityIconOnOSD(const Graphics::Surface *icon) {}
+	virtual void logMessage(LogMessageType::Type type, const char *message) { fputs(message, stderr); }
+
+private:
+	const uint64 _start;
+};
+
+} // End of anonymous namespace
+
+void initSystem() {
+	if (!g_system)
+		g_system = new NullSystem();
+}
+
+} // End of namespace Benchmark
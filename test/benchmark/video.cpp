@@ -0,0 +1,315 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/benchmark/benchmark.h"
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "graphics/conversion.h"
+#include "graphics/surface.h"
+#include "video/avi_decoder.h"
+#ifdef USE_BINK
+#include "video/bink_decoder.h"
+#endif
+#include "video/coktel_decoder.h"
+#include "video/dxa_decoder.h"
+#include "video/flic_decoder.h"
+#include "video/mpegps_decoder.h"
+#include "video/mve_decoder.h"
+#include "video/psx_decoder.h"
+#include "video/qt_decoder.h"
+#include "video/smk_decoder.h"
+#ifdef USE_THEORADEC
+#include "video/theora_decoder.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+namespace Benchmark {
+
+namespace {
+
+struct DecoderType {
+	const char *name;
+	const char *extensions;
+	Video::VideoDecoder *(*create)();
+};
+
+Video::VideoDecoder *createAVI() { return new Video::AVIDecoder(); }
+#ifdef USE_BINK
+Video::VideoDecoder *createBink() { return new Video::BinkDecoder(); }
+#endif
+Video::VideoDecoder *createDXA() { return new Video::DXADecoder(); }
+Video::VideoDecoder *createFlic() { return new Video::FlicDecoder(); }
+Video::VideoDecoder *createMPEGPS() { return new Video::MPEGPSDecoder(); }
+Video::VideoDecoder *createMve() { return new Video::MveDecoder(); }
+Video::VideoDecoder *createPSX() { return new Video::PSXStreamDecoder(Video::PSXStreamDecoder::kCD2x); }
+Video::VideoDecoder *createQuickTime() { return new Video::QuickTimeDecoder(); }
+Video::VideoDecoder *createSmacker() { return new Video::SmackerDecoder(); }
+#ifdef USE_THEORADEC
+Video::VideoDecoder *createTheora() { return new Video::TheoraDecoder(); }
+#endif
+Video::VideoDecoder *createVMD() { return new Video::AdvancedVMDDecoder(); }
+
+const DecoderType s_decoders[] = {
+	{ "avi", "avi", createAVI },
+#ifdef USE_BINK
+	{ "bink", "bik", createBink },
+#endif
+	{ "dxa", "dxa", createDXA },
+	{ "flic", "fli flc", createFlic },
+	{ "mpegps", "mpg mpeg vob", createMPEGPS },
+	{ "mve", "mve", createMve },
+	{ "psx", "str", createPSX },
+	{ "qt", "mov qt", createQuickTime },
+	{ "smk", "smk", createSmacker },
+#ifdef USE_THEORADEC
+	{ "theora", "ogg ogv", createTheora },
+#endif
+	{ "vmd", "vmd", createVMD },
+	{ nullptr, nullptr, nullptr }
+};
+
+const DecoderType *findDecoder(const Common::String &name) {
+	for (const DecoderType *d = s_decoders; d->name; ++d)
+		if (name.equalsIgnoreCase(d->name))
+			return d;
+
+	return nullptr;
+}
+
+const DecoderType *findDecoderForFile(const Common::String &fileName) {
+	const char *dot = strrchr(fileName.c_str(), '.');
+	if (!dot)
+		return nullptr;
+
+	const Common::String extension = Common::String(dot + 1);
+	for (const DecoderType *d = s_decoders; d->name; ++d) {
+		Common::String list = d->extensions;
+		for (const char *ext = strtok(list.begin(), " "); ext; ext = strtok(nullptr, " "))
+			if (extension.equalsIgnoreCase(ext))
+				return d;
+	}
+
+	return nullptr;
+}
+
+bool parseFormat(const Common::String &name, Graphics::PixelFormat &format) {
+	if (name == "565")
+		format = Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+	else if (name == "555")
+		format = Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0);
+	else if (name == "8888")
+		format = Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	else
+		return false;
+
+	return true;
+}
+
+Common::SeekableReadStream *readFile(const char *fileName) {
+	FILE *file = fopen(fileName, "rb");
+	if (!file)
+		return nullptr;
+
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	byte *data = (byte *)malloc(MAX<long>(size, 1));
+	if (size < 0 || fread(data, 1, size, file) != (size_t)size) {
+		free(data);
+		fclose(file);
+		return nullptr;
+	}
+
+	fclose(file);
+	return new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+// Peak resident set size of the process in KiB.
+long getPeakMemory() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+/**
+ * Converts frames to a high color format the way an engine would before
+ * handing them to the backend, including palette lookups for 8bpp video.
+ */
+class FrameConverter {
+public:
+	FrameConverter(const Graphics::PixelFormat &format) : _format(format) {
+		memset(_colors, 0, sizeof(_colors));
+	}
+
+	~FrameConverter() { _surface.free(); }
+
+	void setPalette(const byte *palette) {
+		for (int i = 0; i < 256; ++i)
+			_colors[i] = _format.RGBToColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+	}
+
+	void convert(const Graphics::Surface &frame) {
+		if (_surface.w != frame.w || _surface.h != frame.h) {
+			_surface.free();
+			_surface.create(frame.w, frame.h, _format);
+		}
+
+		if (frame.format.bytesPerPixel != 1) {
+			Graphics::crossBlit((byte *)_surface.getPixels(), (const byte *)frame.getPixels(), _surface.pitch, frame.pitch,
+								frame.w, frame.h, _format, frame.format);
+			return;
+		}
+
+		for (int y = 0; y < frame.h; ++y) {
+			const byte *src = (const byte *)frame.getBasePtr(0, y);
+			if (_format.bytesPerPixel == 2) {
+				uint16 *dst = (uint16 *)_surface.getBasePtr(0, y);
+				for (int x = 0; x < frame.w; ++x)
+					dst[x] = _colors[src[x]];
+			} else {
+				uint32 *dst = (uint32 *)_surface.getBasePtr(0, y);
+				for (int x = 0; x < frame.w; ++x)
+					dst[x] = _colors[src[x]];
+			}
+		}
+	}
+
+private:
+	const Graphics::PixelFormat _format;
+	Graphics::Surface _surface;
+	uint32 _colors[256];
+};
+
+uint32 percentile(const Common::Array<uint32> &sorted, uint percent) {
+	return sorted[MIN<uint>((sorted.size() - 1) * percent / 100, sorted.size() - 1)];
+}
+
+void usage() {
+	printf("Expected: <file> [decoder|auto] [565|555|8888]\nDecoders:");
+	for (const DecoderType *d = s_decoders; d->name; ++d)
+		printf(" %s", d->name);
+	printf("\n");
+}
+
+} // End of anonymous namespace
+
+int runVideo(int argc, const char *const *argv) {
+	if (argc < 1) {
+		usage();
+		return 1;
+	}
+
+	const char *fileName = argv[0];
+	const DecoderType *type = (argc > 1 && strcmp(argv[1], "auto")) ? findDecoder(argv[1]) : findDecoderForFile(fileName);
+	if (!type) {
+		usage();
+		return 1;
+	}
+
+	Graphics::PixelFormat format;
+	const bool convert = argc > 2;
+	if (convert && !parseFormat(argv[2], format)) {
+		usage();
+		return 1;
+	}
+
+	initSystem();
+
+	Common::SeekableReadStream *stream = readFile(fileName);
+	if (!stream) {
+		printf("Could not read %s\n", fileName);
+		return 1;
+	}
+
+	const long memoryBefore = getPeakMemory();
+
+	Video::VideoDecoder *decoder = type->create();
+	const uint64 loadStart = getMicros();
+	if (!decoder->loadStream(stream)) {
+		printf("The %s decoder could not load %s\n", type->name, fileName);
+		delete decoder;
+		return 1;
+	}
+	const uint64 loadTime = getMicros() - loadStart;
+
+	printf("%s: %s, %dx%d, %d bpp, %d frames\n", fileName, type->name, decoder->getWidth(), decoder->getHeight(),
+		   decoder->getPixelFormat().bytesPerPixel * 8, decoder->getFrameCount());
+
+	FrameConverter converter(convert ? format : Graphics::PixelFormat::createFormatCLUT8());
+	Common::Array<uint32> frameTimes;
+	uint32 nullFrames = 0;
+
+	// Decode as fast as possible, without waiting for frames to become due.
+	// Audio is queued but never played, so stop once the video tracks no
+	// longer advance even when audio is left.
+	const uint64 start = getMicros();
+	while (!decoder->endOfVideo()) {
+		const int curFrame = decoder->getCurFrame();
+
+		const uint64 frameStart = getMicros();
+		const Graphics::Surface *frame = decoder->decodeNextFrame();
+		if (convert && frame) {
+			if (frame->format.bytesPerPixel == 1 && decoder->hasDirtyPalette())
+				converter.setPalette(decoder->getPalette());
+			converter.convert(*frame);
+		}
+		const uint64 frameTime = getMicros() - frameStart;
+
+		if (decoder->getCurFrame() == curFrame)
+			break;
+
+		frameTimes.push_back((uint32)frameTime);
+		if (!frame)
+			++nullFrames;
+	}
+	const uint64 elapsed = MAX<uint64>(getMicros() - start, 1);
+
+	if (frameTimes.empty()) {
+		printf("No frames decoded\n");
+		delete decoder;
+		return 1;
+	}
+
+	Common::sort(frameTimes.begin(), frameTimes.end());
+
+	printf("%u frames (%u empty)%s%s in %.3f s, load %.3f ms\n", frameTimes.size(), nullFrames,
+		   convert ? ", converted to " : "", convert ? argv[2] : "", elapsed / 1000000.0, loadTime / 1000.0);
+	printf("%.1f frames/s\n", (double)frameTimes.size() * 1000000.0 / elapsed);
+	printf("frame time us: p50 %u  p90 %u  p99 %u  max %u\n", percentile(frameTimes, 50), percentile(frameTimes, 90),
+		   percentile(frameTimes, 99), frameTimes.back());
+	printf("peak memory: %ld KiB (%ld KiB before loading)\n", getPeakMemory(), memoryBefore);
+
+	delete decoder;
+	return 0;
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,90 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/xmlparser.h"
+
+class XMLParserTestSuite : public CxxTest::TestSuite
+{
+	// Writes down the keys it is called for, in the order it is called.
+	class ItemParser : public Common::XMLParser {
+	public:
+		Common::String _log;
+
+	protected:
+		CUSTOM_XML_PARSER(ItemParser) {
+			XML_KEY(list)
+				XML_PROP(name, true)
+				XML_KEY(item)
+					XML_PROP(id, true)
+					XML_PROP(size, false)
+				KEY_END()
+			KEY_END()
+		} PARSER_END()
+
+		bool parserCallback_list(ParserNode *node) {
+			_log += "list " + node->values["name"] + ";";
+			return true;
+		}
+
+		bool parserCallback_item(ParserNode *node) {
+			_log += "item " + node->values["id"];
+			if (node->values.contains("size"))
+				_log += " " + node->values["size"];
+			_log += ";";
+			return true;
+		}
+
+		bool closedKeyCallback(ParserNode *node) override {
+			_log += "/" + node->name + ";";
+			return true;
+		}
+	};
+
+	public:
+	void test_text() {
+		static const char xml[] =
+			"<?xml version = '1.0'?>"
+			"<!-- comment -->"
+			"<list name = 'a b'>"
+			"  <item id = 1 size = '2, 3'/>"
+			"  <item id = \"x\"></item>"
+			"</list>";
+
+		ItemParser parser;
+		TS_ASSERT(parser.loadBuffer((const byte *)xml, sizeof(xml) - 1));
+		TS_ASSERT(parser.parse());
+		TS_ASSERT(!parser.isBinary());
+		TS_ASSERT_EQUALS(parser._log, "/xml;list a b;item 1 2, 3;/item;item x;/item;/list;");
+	}
+
+	void test_binary() {
+		// The keys of test_text, as created by scummtheme.py. There is no
+		// XML header in binary files, and the size and MD5 of the text are
+		// left out as the parser does not check them.
+		static const byte data[] = {
+			'B', 'X', 'M', 'L', 2, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			9, 0,
+			4, 0, 'l', 'i', 's', 't',
+			4, 0, 'n', 'a', 'm', 'e',
+			3, 0, 'a', ' ', 'b',
+			4, 0, 'i', 't', 'e', 'm',
+			2, 0, 'i', 'd',
+			1, 0, '1',
+			4, 0, 's', 'i', 'z', 'e',
+			4, 0, '2', ',', ' ', '3',
+			1, 0, 'x',
+			Common::XMLParser::kBinaryKey, 0, 0, 1, 1, 0, 2, 0,
+			Common::XMLParser::kBinaryClosedKey, 3, 0, 2, 4, 0, 5, 0, 6, 0, 7, 0,
+			Common::XMLParser::kBinaryKey, 3, 0, 1, 4, 0, 8, 0,
+			Common::XMLParser::kBinaryKeyEnd,
+			Common::XMLParser::kBinaryKeyEnd,
+			Common::XMLParser::kBinaryEnd
+		};
+
+		ItemParser parser;
+		TS_ASSERT(parser.loadBuffer(data, sizeof(data)));
+		TS_ASSERT(parser.parse());
+		TS_ASSERT(parser.isBinary());
+		TS_ASSERT_EQUALS(parser._log, "list a b;item 1 2, 3;/item;item x;/item;/list;");
+	}
+};
@@ -0,0 +1,162 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/c2p.h"
+
+class ChunkyToPlanarTestSuite : public CxxTest::TestSuite
+{
+	struct Bitmap {
+		Bitmap(uint16 w, uint16 h, byte depth = 8) {
+			planar.bytesPerRow = ((w + 31) / 32) * 4;
+			planar.rows = h;
+			planar.depth = depth;
+			for (int i = 0; i < 8; ++i)
+				planar.planes[i] = i < depth ? new byte[planar.bytesPerRow * h]() : nullptr;
+		}
+		~Bitmap() {
+			for (int i = 0; i < 8; ++i)
+				delete[] planar.planes[i];
+		}
+
+		Graphics::PlanarBitmap planar;
+	};
+
+	static void fill(Graphics::Surface &s, uint32 seed) {
+		for (int y = 0; y < s.h; ++y) {
+			for (int x = 0; x < s.w; ++x) {
+				seed = seed * 1103515245 + 12345;
+				*(byte *)s.getBasePtr(x, y) = seed >> 16;
+			}
+		}
+	}
+
+	static bool equal(const Graphics::Surface &a, const Graphics::Surface &b, byte mask = 0xff) {
+		for (int y = 0; y < a.h; ++y)
+			for (int x = 0; x < a.w; ++x)
+				if ((*(const byte *)a.getBasePtr(x, y) & mask) != (*(const byte *)b.getBasePtr(x, y) & mask))
+					return false;
+		return true;
+	}
+
+	void roundTrip(Graphics::C2PMethod method, uint16 w, uint16 h) {
+		Graphics::Surface chunky, back;
+		chunky.create(w, h, Graphics::PixelFormat::createFormatCLUT8());
+		back.create(w, h, Graphics::PixelFormat::createFormatCLUT8());
+		fill(chunky, w * h);
+
+		Bitmap bitmap(w, h);
+		Graphics::ChunkyToPlanar c2p(method);
+		c2p.convert(chunky, bitmap.planar);
+		Graphics::planarToChunky(bitmap.planar, back);
+		TS_ASSERT(equal(chunky, back));
+
+		chunky.free();
+		back.free();
+	}
+
+	public:
+	void test_layout() {
+		Graphics::Surface chunky;
+		chunky.create(32, 1, Graphics::PixelFormat::createFormatCLUT8());
+		memset(chunky.getPixels(), 0, 32);
+		*(byte *)chunky.getBasePtr(0, 0) = 0x01;
+		*(byte *)chunky.getBasePtr(9, 0) = 0x80;
+		*(byte *)chunky.getBasePtr(31, 0) = 0x05;
+
+		Bitmap bitmap(32, 1);
+		Graphics::ChunkyToPlanar c2p(Graphics::kC2PMerge);
+		c2p.convert(chunky, bitmap.planar);
+
+		TS_ASSERT_EQUALS(bitmap.planar.planes[0][0], 0x80);
+		TS_ASSERT_EQUALS(bitmap.planar.planes[0][3], 0x01);
+		TS_ASSERT_EQUALS(bitmap.planar.planes[2][3], 0x01);
+		TS_ASSERT_EQUALS(bitmap.planar.planes[7][1], 0x40);
+		TS_ASSERT_EQUALS(bitmap.planar.planes[1][0], 0x00);
+
+		chunky.free();
+	}
+
+	void test_round_trip_reference() {
+		roundTrip(Graphics::kC2PReference, 320, 200);
+		roundTrip(Graphics::kC2PReference, 100, 7);
+	}
+
+	void test_round_trip_merge() {
+		roundTrip(Graphics::kC2PMerge, 320, 200);
+		roundTrip(Graphics::kC2PMerge, 100, 7);
+		roundTrip(Graphics::kC2PMerge, 31, 3);
+	}
+
+	void test_methods_agree_on_area() {
+		Graphics::Surface chunky;
+		chunky.create(320, 16, Graphics::PixelFormat::createFormatCLUT8());
+		fill(chunky, 42);
+
+		Bitmap a(320, 16), b(320, 16);
+		Graphics::ChunkyToPlanar reference(Graphics::kC2PReference), merge(Graphics::kC2PMerge);
+		const Common::Rect area(13, 2, 250, 11);
+		reference.convert(chunky, area, a.planar);
+		merge.convert(chunky, area, b.planar);
+
+		for (int p = 0; p < 8; ++p)
+			TS_ASSERT_SAME_DATA(a.planar.planes[p], b.planar.planes[p], a.planar.bytesPerRow * 16);
+
+		chunky.free();
+	}
+
+	void test_depth() {
+		Graphics::Surface chunky, back;
+		chunky.create(64, 4, Graphics::PixelFormat::createFormatCLUT8());
+		back.create(64, 4, Graphics::PixelFormat::createFormatCLUT8());
+		fill(chunky, 7);
+
+		Bitmap bitmap(64, 4, 5);
+		Graphics::ChunkyToPlanar c2p(Graphics::kC2PMerge);
+		c2p.convert(chunky, bitmap.planar);
+		Graphics::planarToChunky(bitmap.planar, back);
+		TS_ASSERT(equal(chunky, back, 0x1f));
+
+		chunky.free();
+		back.free();
+	}
+
+	void test_delta() {
+		Graphics::Surface chunky, back;
+		chunky.create(320, 10, Graphics::PixelFormat::createFormatCLUT8());
+		back.create(320, 10, Graphics::PixelFormat::createFormatCLUT8());
+		fill(chunky, 1);
+
+		Bitmap bitmap(320, 10);
+		Graphics::ChunkyToPlanar c2p(Graphics::kC2PMerge);
+		c2p.setDeltaMode(true);
+
+		c2p.convert(chunky, bitmap.planar);
+		TS_ASSERT_EQUALS(c2p.getGroupsWritten(), (uint32)100);
+		TS_ASSERT_EQUALS(c2p.getGroupsSkipped(), (uint32)0);
+
+		// Nothing changed.
+		c2p.resetStats();
+		c2p.convert(chunky, bitmap.planar);
+		TS_ASSERT_EQUALS(c2p.getGroupsWritten(), (uint32)0);
+		TS_ASSERT_EQUALS(c2p.getGroupsSkipped(), (uint32)100);
+
+		// Two pixels in separate groups.
+		*(byte *)chunky.getBasePtr(5, 3) ^= 0xff;
+		*(byte *)chunky.getBasePtr(300, 9) ^= 0xff;
+		c2p.resetStats();
+		c2p.convert(chunky, bitmap.planar);
+		TS_ASSERT_EQUALS(c2p.getGroupsWritten(), (uint32)2);
+		TS_ASSERT_EQUALS(c2p.getGroupsSkipped(), (uint32)98);
+
+		Graphics::planarToChunky(bitmap.planar, back);
+		TS_ASSERT(equal(chunky, back));
+
+		// After invalidating, everything is written again.
+		c2p.invalidate();
+		c2p.resetStats();
+		c2p.convert(chunky, bitmap.planar);
+		TS_ASSERT_EQUALS(c2p.getGroupsWritten(), (uint32)100);
+
+		chunky.free();
+		back.free();
+	}
+};
@@ -0,0 +1,193 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirtyrects.h"
+
+class DirtyRectListTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_starts_all_dirty() {
+		Graphics::DirtyRectList list;
+		list.setBounds(320, 200);
+		TS_ASSERT(list.isAllDirty());
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+		TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(320, 200));
+
+		list.clear();
+		TS_ASSERT(list.empty());
+		TS_ASSERT(!list.isAllDirty());
+	}
+
+	void test_clip() {
+		Graphics::DirtyRectList list;
+		list.setBounds(320, 200);
+		list.clear();
+
+		list.addRect(Common::Rect(300, 190, 340, 220));
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+		TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(300, 190, 320, 200));
+
+		list.addRect(Common::Rect(400, 0, 410, 10));
+		list.addRect(Common::Rect(10, 10, 10, 20));
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+	}
+
+	void test_contained() {
+		Graphics::DirtyRectList list;
+		list.setBounds(320, 200);
+		list.clear();
+
+		list.addRect(Common::Rect(10, 10, 50, 50));
+		list.addRect(Common::Rect(20, 20, 30, 30));
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+		TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(10, 10, 50, 50));
+
+		list.addRect(Common::Rect(0, 0, 60, 60));
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+		TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(0, 0, 60, 60));
+	}
+
+	void test_merge_adjacent() {
+		Graphics::DirtyRectList list;
+		list.setBounds(320, 200);
+		list.clear();
+
+		// Two halves of one sprite become one rectangle.
+		list.addRect(Common::Rect(10, 10, 20, 30));
+		list.addRect(Common::Rect(20, 10, 30, 30));
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+		TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(10, 10, 30, 30));
+	}
+
+	void test_keep_distant_apart() {
+		Graphics::DirtyRectList list;
+		list.setBounds(320, 200);
+		list.clear();
+
+		// Sprites in opposite corners must not cover the whole screen.
+		list.addRect(Common::Rect(0, 0, 16, 16));
+		list.addRect(Common::Rect(300, 180, 316, 196));
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)2);
+		TS_ASSERT_EQUALS(list.getDirtyArea(), (uint32)512);
+		TS_ASSERT(!list.isAllDirty());
+	}
+
+	void test_alignment() {
+		Graphics::DirtyRectList list;
+		list.setBounds(320, 200);
+		list.setAlignment(32);
+		list.clear();
+
+		list.addRect(Common::Rect(33, 0, 65, 1));
+		TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(32, 0, 96, 1));
+
+		list.clear();
+		list.addRect(Common::Rect(310, 0, 315, 1));
+		TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(288, 0, 320, 1));
+	}
+
+	void test_max_rects() {
+		Graphics::DirtyRectList list(4);
+		list.setBounds(320, 200);
+		list.clear();
+
+		for (int i = 0; i < 8; ++i)
+			list.addRect(Common::Rect(i * 40, i * 20, i * 40 + 4, i * 20 + 4));
+
+		TS_ASSERT(list.getRects().size() <= 4);
+
+		// Every added area is still covered.
+		for (int i = 0; i < 8; ++i) {
+			bool covered = false;
+			for (uint j = 0; j < list.getRects().size(); ++j)
+				covered |= list.getRects()[j].contains(Common::Rect(i * 40, i * 20, i * 40 + 4, i * 20 + 4));
+			TS_ASSERT(covered);
+		}
+	}
+
+	void test_collapse_to_full() {
+		Graphics::DirtyRectList list;
+		list.setBounds(320, 200);
+		list.clear();
+
+		list.addRect(Common::Rect(0, 0, 320, 160));
+		TS_ASSERT(list.isAllDirty());
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+		TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(320, 200));
+
+		// Nothing can be added once everything is dirty.
+		list.addRect(Common::Rect(0, 0, 10, 10));
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+	}
+
+	void test_add_rects() {
+		Graphics::DirtyRectList a, b;
+		a.setBounds(320, 200);
+		b.setBounds(320, 200);
+		a.clear();
+		b.clear();
+
+		a.addRect(Common::Rect(0, 0, 8, 8));
+		b.addRect(Common::Rect(100, 100, 108, 108));
+		b.addRects(a);
+		TS_ASSERT_EQUALS(b.getRects().size(), (uint)2);
+
+		a.markAll();
+		b.addRects(a);
+		TS_ASSERT(b.isAllDirty());
+	}
+
+	void test_block_collector() {
+		Graphics::DirtyRectList list;
+		list.setBounds(320, 200);
+		list.clear();
+
+		{
+			Graphics::DirtyBlockCollector blocks(&list);
+			for (int x = 0; x < 16; x += 4)
+				blocks.addBlock(x, 8, 4, 4);
+			TS_ASSERT(list.empty());
+
+			// A gap in the row ends the run.
+			blocks.addBlock(100, 8, 4, 4);
+			TS_ASSERT_EQUALS(list.getRects().size(), (uint)1);
+			TS_ASSERT_EQUALS(list.getRects()[0], Common::Rect(0, 8, 16, 12));
+		}
+
+		// The last run is added when the collector goes out of scope.
+		TS_ASSERT_EQUALS(list.getRects().size(), (uint)2);
+		TS_ASSERT_EQUALS(list.getRects()[1], Common::Rect(100, 8, 104, 12));
+	}
+
+	void test_copy_spans() {
+		Common::Array<Common::Rect> rects;
+		Common::Array<Graphics::CopySpan> spans;
+
+		// Rows of a partial width rect are copied one by one.
+		rects.push_back(Common::Rect(4, 2, 12, 4));
+		Graphics::computeCopySpans(rects, 1, 320, 384, spans);
+		TS_ASSERT_EQUALS(spans.size(), (uint)2);
+		TS_ASSERT_EQUALS(spans[0].srcOffset, (uint32)(2 * 320 + 4));
+		TS_ASSERT_EQUALS(spans[0].dstOffset, (uint32)(2 * 384 + 4));
+		TS_ASSERT_EQUALS(spans[0].length, (uint32)8);
+		TS_ASSERT_EQUALS(spans[1].srcOffset, (uint32)(3 * 320 + 4));
+		TS_ASSERT_EQUALS(spans[1].dstOffset, (uint32)(3 * 384 + 4));
+
+		// Full rows with equal pitches become a single span.
+		rects.clear();
+		spans.clear();
+		rects.push_back(Common::Rect(0, 10, 320, 20));
+		Graphics::computeCopySpans(rects, 1, 320, 320, spans);
+		TS_ASSERT_EQUALS(spans.size(), (uint)1);
+		TS_ASSERT_EQUALS(spans[0].srcOffset, (uint32)(10 * 320));
+		TS_ASSERT_EQUALS(spans[0].length, (uint32)(10 * 320));
+
+		// Bytes per pixel are taken into account.
+		rects.clear();
+		spans.clear();
+		rects.push_back(Common::Rect(1, 1, 3, 2));
+		Graphics::computeCopySpans(rects, 2, 640, 640, spans);
+		TS_ASSERT_EQUALS(spans.size(), (uint)1);
+		TS_ASSERT_EQUALS(spans[0].srcOffset, (uint32)642);
+		TS_ASSERT_EQUALS(spans[0].length, (uint32)4);
+	}
+};
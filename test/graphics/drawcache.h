@@ -0,0 +1,186 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/drawcache.h"
+#include "graphics/surface.h"
+#include "graphics/transparent_surface.h"
+#include "graphics/VectorRendererSpec.h"
+
+class DrawCacheTestSuite : public CxxTest::TestSuite
+{
+	Graphics::Surface _surface;
+
+	void fill(const Common::Rect &r, uint16 color) {
+		_surface.fillRect(r, color);
+	}
+
+	bool isFilled(const Common::Rect &r, uint16 color) {
+		for (int y = r.top; y < r.bottom; ++y)
+			for (int x = r.left; x < r.right; ++x)
+				if (*(const uint16 *)_surface.getBasePtr(x, y) != color)
+					return false;
+		return true;
+	}
+
+	// Draws a frame with a differently colored inside, which is restored
+	// from the cache when possible.
+	bool draw(Graphics::DrawCache &cache, uint32 id, uint32 state, const Common::Rect &r) {
+		if (cache.begin(id, &state, 1, r, _surface, r))
+			return true;
+
+		fill(r, 0xF800);
+		Common::Rect inside = r;
+		inside.grow(-1);
+		fill(inside, (uint16)state);
+		cache.end(_surface);
+		return false;
+	}
+
+	// Draws a gradient filled square, keyed by the parity of its position
+	// like ThemeEngine does.
+	bool drawGradient(Graphics::DrawCache &cache, Graphics::VectorRenderer &renderer, const Common::Rect &r) {
+		uint32 state = (r.left & 1) | ((r.top & 1) << 1);
+		Graphics::Surface &surface = *renderer.getActiveSurface();
+		// The renderer may touch the pixels just past the square
+		Common::Rect changed = r;
+		changed.grow(2);
+		if (cache.begin(1, &state, 1, r, surface, changed))
+			return true;
+
+		renderer.drawRoundedSquare(r.left, r.top, 4, r.width(), r.height());
+		cache.end(surface);
+		return false;
+	}
+
+	public:
+	void setUp() {
+		_surface.create(64, 64, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		fill(Common::Rect(64, 64), 0x1234);
+	}
+
+	void tearDown() {
+		_surface.free();
+	}
+
+	void test_reuse() {
+		Graphics::DrawCache cache(64 * 1024);
+		const Common::Rect r(4, 4, 20, 12);
+
+		TS_ASSERT(!draw(cache, 1, 0x07E0, r));
+		TS_ASSERT_EQUALS(cache.getEntryCount(), (uint)1);
+
+		fill(r, 0x1234);
+		TS_ASSERT(draw(cache, 1, 0x07E0, r));
+		TS_ASSERT(isFilled(Common::Rect(5, 5, 19, 11), 0x07E0));
+		TS_ASSERT_EQUALS(cache.getHits(), (uint32)1);
+		TS_ASSERT_EQUALS(cache.getMisses(), (uint32)1);
+
+		// The same element on the same background elsewhere.
+		TS_ASSERT(draw(cache, 1, 0x07E0, Common::Rect(30, 40, 46, 48)));
+		TS_ASSERT(isFilled(Common::Rect(31, 41, 45, 47), 0x07E0));
+	}
+
+	void test_different_element() {
+		Graphics::DrawCache cache(64 * 1024);
+		const Common::Rect r(4, 4, 20, 12);
+
+		TS_ASSERT(!draw(cache, 1, 0x07E0, r));
+		fill(r, 0x1234);
+
+		TS_ASSERT(!draw(cache, 2, 0x07E0, r));
+		fill(r, 0x1234);
+		TS_ASSERT(!draw(cache, 1, 0x001F, r));
+		TS_ASSERT(isFilled(Common::Rect(5, 5, 19, 11), 0x001F));
+		TS_ASSERT(!draw(cache, 1, 0x07E0, Common::Rect(4, 4, 20, 13)));
+		TS_ASSERT_EQUALS(cache.getEntryCount(), (uint)4);
+	}
+
+	void test_different_background() {
+		Graphics::DrawCache cache(64 * 1024);
+		const Common::Rect r(4, 4, 20, 12);
+
+		TS_ASSERT(!draw(cache, 1, 0x07E0, r));
+
+		// Drawing over the element itself must not restore it as it was
+		// drawn over the plain background.
+		TS_ASSERT(!draw(cache, 1, 0x07E0, r));
+
+		fill(r, 0x1234);
+		fill(Common::Rect(10, 8, 11, 9), 0);
+		TS_ASSERT(!draw(cache, 1, 0x07E0, r));
+	}
+
+	void test_evict_oldest() {
+		// Room for four 16x8 elements, each storing two copies of 256 bytes.
+		Graphics::DrawCache cache(4 * 2 * 16 * 8 * 2);
+		const Common::Rect r(4, 4, 20, 12);
+
+		for (uint32 id = 1; id <= 4; ++id) {
+			TS_ASSERT(!draw(cache, id, 0, r));
+			fill(r, 0x1234);
+		}
+
+		TS_ASSERT(draw(cache, 1, 0, r));
+		fill(r, 0x1234);
+		TS_ASSERT(!draw(cache, 5, 0, r));
+		fill(r, 0x1234);
+		TS_ASSERT_EQUALS(cache.getEntryCount(), (uint)4);
+		TS_ASSERT_EQUALS(cache.getSize(), (uint32)(4 * 2 * 16 * 8 * 2));
+
+		// The least recently used element made room.
+		TS_ASSERT(draw(cache, 1, 0, r));
+		fill(r, 0x1234);
+		TS_ASSERT(!draw(cache, 2, 0, r));
+	}
+
+	void test_too_large() {
+		Graphics::DrawCache cache(1024);
+
+		TS_ASSERT(!draw(cache, 1, 0, Common::Rect(0, 0, 32, 32)));
+		TS_ASSERT_EQUALS(cache.getEntryCount(), (uint)0);
+		TS_ASSERT_EQUALS(cache.getSize(), (uint32)0);
+	}
+
+	void test_gradient_parity() {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Graphics::TransparentSurface cached, drawn;
+		cached.create(64, 64, format);
+		drawn.create(64, 64, format);
+
+		Graphics::VectorRendererSpec<uint16> renderer(format);
+		renderer.setFillMode(Graphics::VectorRenderer::kFillGradient);
+		renderer.setGradientColors(0, 0, 0, 255, 255, 255);
+		renderer.setStrokeWidth(0);
+
+		Graphics::DrawCache cache(64 * 1024);
+		static const int left[] = { 4, 6, 5, 7 };
+		for (int i = 0; i < ARRAYSIZE(left); ++i) {
+			const Common::Rect r(left[i], 8, left[i] + 24, 40);
+			cached.fillRect(Common::Rect(64, 64), 0);
+			drawn.fillRect(Common::Rect(64, 64), 0);
+
+			renderer.setSurface(&cached);
+			// Only the first square of each parity is actually drawn
+			TS_ASSERT_EQUALS(drawGradient(cache, renderer, r), (i % 2) == 1);
+
+			renderer.setSurface(&drawn);
+			renderer.drawRoundedSquare(r.left, r.top, 4, r.width(), r.height());
+			TS_ASSERT(!memcmp(cached.getPixels(), drawn.getPixels(), drawn.pitch * drawn.h));
+		}
+
+		cached.free();
+		drawn.free();
+	}
+
+	void test_clear() {
+		Graphics::DrawCache cache(64 * 1024);
+		const Common::Rect r(4, 4, 20, 12);
+
+		TS_ASSERT(!draw(cache, 1, 0, r));
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getEntryCount(), (uint)0);
+		TS_ASSERT_EQUALS(cache.getSize(), (uint32)0);
+
+		fill(r, 0x1234);
+		TS_ASSERT(!draw(cache, 1, 0, r));
+	}
+};
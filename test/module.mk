@@ -5,8 +5,8 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h
+TEST_LIBS    := audio/libaudio.a graphics/libgraphics.a common/libcommon.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -47,8 +47,23 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+######################################################################
+# Benchmarks, not part of the 'test' target. Pick one with BENCH_ARGS,
+# e.g. "make bench BENCH_ARGS='c2p 1000'", or run test/benchmark/bench
+# without arguments for a list.
+######################################################################
+
+BENCH_SRCS   := $(wildcard $(srcdir)/test/benchmark/*.cpp)
+BENCH_LIBS   := video/libvideo.a image/libimage.a graphics/libgraphics.a audio/libaudio.a common/libcommon.a
+
+bench: test/benchmark/bench
+	./test/benchmark/bench $(BENCH_ARGS)
+test/benchmark/bench: $(BENCH_SRCS) $(BENCH_LIBS)
+	@mkdir -p test/benchmark
+	$(QUIET_CXX)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ $+ $(filter-out -v,$(TEST_LDFLAGS))
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/runner.cpp test/runner test/benchmark/bench
 
-.PHONY: test clean-test
+.PHONY: test bench clean-test
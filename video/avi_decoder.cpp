@@ -447,6 +447,23 @@ bool AVIDecoder::loadStream(Common::SeekableReadStream *stream) {
 		}
 	}
 
+	// Remember the key frames of the video, frames before them can be dropped
+	if (!_videoTracks.empty() && !_indexEntries.empty()) {
+		const uint32 videoIndex = _videoTracks[0].index;
+		Common::Array<bool> keyFrames;
+
+		for (uint32 i = 0; i < _indexEntries.size(); i++) {
+			const OldIndex &entry = _indexEntries[i];
+
+			if (entry.id == ID_REC || getStreamIndex(entry.id) != videoIndex || getStreamType(entry.id) == kStreamTypePaletteChange)
+				continue;
+
+			keyFrames.push_back((entry.flags & AVIIF_INDEX) || keyFrames.empty());
+		}
+
+		((AVIVideoTrack *)_videoTracks[0].track)->setKeyFrames(keyFrames);
+	}
+
 	// If there is a transparency track, remove it from the video decoder's track list.
 	// This is to stop it being included in calls like getFrameCount
 	if (_transparencyTrack.track)
@@ -910,6 +927,10 @@ AVIDecoder::AVIVideoTrack::AVIVideoTrack(int frameCount, const AVIStreamHeader &
 		: _frameCount(frameCount), _vidsHeader(streamHeader), _bmInfo(bitmapInfoHeader), _initialPalette(initialPalette) {
 	_videoCodec = createCodec();
 	_lastFrame = 0;
+	_dirtyRegion = 0;
+	_framesDecoded = 0;
+	_trackDirtyRegion = false;
+	_dropFrame = false;
 	_curFrame = -1;
 	_reversed = false;
 
@@ -923,13 +944,20 @@ AVIDecoder::AVIVideoTrack::~AVIVideoTrack() {
 
 void AVIDecoder::AVIVideoTrack::decodeFrame(Common::SeekableReadStream *stream) {
 	if (stream) {
-		if (_videoCodec)
+		if (_dropFrame) {
+			// Dropped, no later frame is decoded from this one
+			_lastFrame = 0;
+		} else if (_videoCodec) {
 			_lastFrame = _videoCodec->decodeFrame(*stream);
+			_framesDecoded++;
+		}
 	} else {
 		// Empty frame
 		_lastFrame = 0;
 	}
 
+	_dropFrame = false;
+
 	delete stream;
 
 	if (!_reversed) {
@@ -939,6 +967,26 @@ void AVIDecoder::AVIVideoTrack::decodeFrame(Common::SeekableReadStream *stream)
 	}
 }
 
+const Graphics::Surface *AVIDecoder::AVIVideoTrack::decodeNextFrame() {
+	// The codec reports what changed since the frame it decoded before, which
+	// is only the frame returned last if no seek decoded further frames.
+	_dirtyRegion = (_lastFrame && _framesDecoded == 1) ? _videoCodec->getDirtyRegion() : 0;
+	_framesDecoded = 0;
+	_dropFrame = false;
+	return _lastFrame;
+}
+
+bool AVIDecoder::AVIVideoTrack::dropNextFrame() {
+	// Frames are decoded on top of the one before them, except for key
+	// frames. So only a frame followed by a key frame can be left out.
+	const uint nextFrame = _curFrame + 2;
+	if (_reversed || nextFrame >= _keyFrames.size() || !_keyFrames[nextFrame])
+		return false;
+
+	_dropFrame = true;
+	return true;
+}
+
 Graphics::PixelFormat AVIDecoder::AVIVideoTrack::getPixelFormat() const {
 	if (_videoCodec)
 		return _videoCodec->getPixelFormat();
@@ -992,7 +1040,12 @@ bool AVIDecoder::AVIVideoTrack::rewind() {
 
 	delete _videoCodec;
 	_videoCodec = createCodec();
+	if (_videoCodec)
+		_videoCodec->setTrackDirtyRegion(_trackDirtyRegion);
 	_lastFrame = 0;
+	_dirtyRegion = 0;
+	_framesDecoded = 0;
+	_dropFrame = false;
 	return true;
 }
 
@@ -1046,6 +1099,14 @@ void AVIDecoder::AVIVideoTrack::setDither(const byte *palette) {
 	_videoCodec->setDither(Image::Codec::kDitherTypeVFW, palette);
 }
 
+void AVIDecoder::AVIVideoTrack::setTrackDirtyRegion(bool track) {
+	// Kept for the codec rewind() creates
+	_trackDirtyRegion = track;
+
+	if (_videoCodec)
+		_videoCodec->setTrackDirtyRegion(track);
+}
+
 AVIDecoder::AVIAudioTrack::AVIAudioTrack(const AVIStreamHeader &streamHeader, const PCMWaveFormat &waveFormat, Audio::Mixer::SoundType soundType) :
 		AudioTrack(soundType),
 		_audsHeader(streamHeader),
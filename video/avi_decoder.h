@@ -217,7 +217,11 @@ protected:
 		int getCurFrame() const { return _curFrame; }
 		int getFrameCount() const { return _frameCount; }
 		Common::String &getName() { return _vidsHeader.name; }
-		const Graphics::Surface *decodeNextFrame() { return _lastFrame; }
+		const Graphics::Surface *decodeNextFrame();
+		void setTrackDirtyRegion(bool track);
+		const Graphics::DirtyRectList *getDirtyRegion() const { return _dirtyRegion; }
+		bool dropNextFrame();
+		void setKeyFrames(const Common::Array<bool> &keyFrames) { _keyFrames = keyFrames; }
 
 		const byte *getPalette() const;
 		bool hasDirtyPalette() const;
@@ -276,6 +280,11 @@ protected:
 
 		Image::Codec *_videoCodec;
 		const Graphics::Surface *_lastFrame;
+		const Graphics::DirtyRectList *_dirtyRegion;
+		uint _framesDecoded;
+		bool _trackDirtyRegion;
+		Common::Array<bool> _keyFrames;
+		bool _dropFrame;
 		Image::Codec *createCodec();
 	};
 
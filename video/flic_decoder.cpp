@@ -91,6 +91,9 @@ FlicDecoder::FlicVideoTrack::FlicVideoTrack(Common::SeekableReadStream *stream,
 
 	_surface = new Graphics::Surface();
 	_surface->create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+	_dirtyRegion.setBounds(width, height);
+	_dirtyRegionFrame = -1;
+	_trackDirtyRegion = false;
 	_palette = new byte[3 * 256];
 	memset(_palette, 0, 3 * 256);
 	_dirtyPalette = false;
@@ -161,6 +164,8 @@ Graphics::PixelFormat FlicDecoder::FlicVideoTrack::getPixelFormat() const {
 #define FRAME_TYPE 0xF1FA
 
 const Graphics::Surface *FlicDecoder::FlicVideoTrack::decodeNextFrame() {
+	_dirtyRegion.clear();
+
 	// Read chunk
 	/*uint32 frameSize = */ _fileStream->readUint32LE();
 	uint16 frameType = _fileStream->readUint16LE();
@@ -176,6 +181,7 @@ const Graphics::Surface *FlicDecoder::FlicVideoTrack::decodeNextFrame() {
 
 	_curFrame++;
 	_nextFrameStartTime += _frameDelay;
+	_dirtyRegionFrame = _curFrame;
 
 	if (_atRingFrame) {
 		// If we decoded the ring frame, seek to the second frame
@@ -208,6 +214,7 @@ void FlicDecoder::FlicVideoTrack::handleFrame() {
 		delete _surface;
 		_surface = new Graphics::Surface();
 		_surface->create(newWidth, newHeight, Graphics::PixelFormat::createFormatCLUT8());
+		_dirtyRegion.setBounds(newWidth, newHeight);
 	}
 
 	// Read subchunks
@@ -260,6 +267,7 @@ void FlicDecoder::FlicVideoTrack::copyFrame(uint8 *data) {
 	// Redraw
 	_dirtyRects.clear();
 	_dirtyRects.push_back(Common::Rect(0, 0, getWidth(), getHeight()));
+	_dirtyRegion.markAll();
 }
 
 void FlicDecoder::FlicVideoTrack::decodeByteRun(uint8 *data) {
@@ -283,6 +291,7 @@ void FlicDecoder::FlicVideoTrack::decodeByteRun(uint8 *data) {
 	// Redraw
 	_dirtyRects.clear();
 	_dirtyRects.push_back(Common::Rect(0, 0, getWidth(), getHeight()));
+	_dirtyRegion.markAll();
 }
 
 #define OP_PACKETCOUNT   0
@@ -312,6 +321,8 @@ void FlicDecoder::FlicVideoTrack::decodeDeltaFLC(uint8 *data) {
 			case OP_LASTPIXEL:
 				*((byte *)_surface->getBasePtr(getWidth() - 1, currentLine)) = (opcode & 0xFF);
 				_dirtyRects.push_back(Common::Rect(getWidth() - 1, currentLine, getWidth(), currentLine + 1));
+				if (_trackDirtyRegion)
+					_dirtyRegion.addRect(Common::Rect(getWidth() - 1, currentLine, getWidth(), currentLine + 1));
 				break;
 			case OP_LINESKIPCOUNT:
 				currentLine += -(int16)opcode;
@@ -329,6 +340,8 @@ void FlicDecoder::FlicVideoTrack::decodeDeltaFLC(uint8 *data) {
 				memcpy((byte *)_surface->getBasePtr(column, currentLine), data, rleCount * 2);
 				data += rleCount * 2;
 				_dirtyRects.push_back(Common::Rect(column, currentLine, column + rleCount * 2, currentLine + 1));
+				if (_trackDirtyRegion)
+					_dirtyRegion.addRect(Common::Rect(column, currentLine, column + rleCount * 2, currentLine + 1));
 			} else if (rleCount < 0) {
 				rleCount = -rleCount;
 				uint16 dataWord = READ_UINT16(data); data += 2;
@@ -336,6 +349,8 @@ void FlicDecoder::FlicVideoTrack::decodeDeltaFLC(uint8 *data) {
 					WRITE_UINT16((byte *)_surface->getBasePtr(column + i * 2, currentLine), dataWord);
 				}
 				_dirtyRects.push_back(Common::Rect(column, currentLine, column + rleCount * 2, currentLine + 1));
+				if (_trackDirtyRegion)
+					_dirtyRegion.addRect(Common::Rect(column, currentLine, column + rleCount * 2, currentLine + 1));
 			} else { // End of cutscene ?
 				return;
 			}
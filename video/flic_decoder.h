@@ -26,6 +26,7 @@
 #include "video/video_decoder.h"
 #include "common/list.h"
 #include "common/rect.h"
+#include "graphics/dirtyrects.h"
 
 namespace Common {
 class SeekableReadStream;
@@ -84,6 +85,11 @@ protected:
 		void clearDirtyRects() { _dirtyRects.clear(); }
 		void copyDirtyRectsToBuffer(uint8 *dst, uint pitch);
 
+		// Only frames decoded by this class' decodeNextFrame() are tracked,
+		// not those of subclasses replacing it.
+		void setTrackDirtyRegion(bool track) { _trackDirtyRegion = track; }
+		const Graphics::DirtyRectList *getDirtyRegion() const { return _trackDirtyRegion && _dirtyRegionFrame == _curFrame ? &_dirtyRegion : 0; }
+
 	protected:
 		Common::SeekableReadStream *_fileStream;
 		Graphics::Surface *_surface;
@@ -101,6 +107,9 @@ protected:
 		uint32 _nextFrameStartTime;
 
 		Common::List<Common::Rect> _dirtyRects;
+		Graphics::DirtyRectList _dirtyRegion;
+		int _dirtyRegionFrame;
+		bool _trackDirtyRegion;
 
 		void copyFrame(uint8 *data);
 		void decodeByteRun(uint8 *data);
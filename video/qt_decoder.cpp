@@ -296,6 +296,10 @@ QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder
 	_curPalette = 0;
 	_dirtyPalette = false;
 	_reversed = false;
+	_dirtyRegion = 0;
+	_lastCodec = 0;
+	_framesBuffered = 0;
+	_dropMode = kDropNone;
 	_forcedDitherPalette = 0;
 	_ditherTable = 0;
 	_ditherFrame = 0;
@@ -469,9 +473,18 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getNextFrameStartTime() const {
 }
 
 const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::decodeNextFrame() {
+	_dirtyRegion = 0;
+
+	const DropMode dropMode = _dropMode;
+	_dropMode = kDropNone;
+
 	if (endOfTrack())
 		return 0;
 
+	Image::Codec *prevCodec = _lastCodec;
+	bool newEdit = false;
+	_framesBuffered = 0;
+
 	if (_reversed) {
 		// Subtract one to place us on the frame before the current displayed frame.
 		_curFrame--;
@@ -499,9 +512,17 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::decodeNextFrame()
 			return 0;
 
 		enterNewEditList(true);
+		newEdit = true;
 	}
 
-	const Graphics::Surface *frame = bufferNextFrame();
+	const Graphics::Surface *frame = bufferNextFrame(dropMode != kDropDecode);
+
+	// The codec reports what changed since the frame it decoded before, which
+	// is only the frame returned last when playing straight on. Scaled or
+	// force dithered frames are left to a full redraw.
+	if (frame && _framesBuffered == 1 && _lastCodec == prevCodec && !_reversed && !newEdit && !_forcedDitherPalette &&
+			_parent->scaleFactorX == 1 && _parent->scaleFactorY == 1 && _decoder->_scaleFactorX == 1 && _decoder->_scaleFactorY == 1)
+		_dirtyRegion = _lastCodec->getDirtyRegion();
 
 	if (_reversed) {
 		if (_durationOverride >= 0) {
@@ -522,6 +543,10 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::decodeNextFrame()
 		}
 	}
 
+	// A dropped frame is neither dithered nor scaled
+	if (dropMode != kDropNone)
+		return 0;
+
 	// Handle forced dithering
 	if (frame && _forcedDitherPalette)
 		frame = forceDither(*frame);
@@ -733,7 +758,30 @@ void QuickTimeDecoder::VideoTrackHandler::enterNewEditList(bool bufferFrames) {
 	_nextFrameStartTime = getCurEditTimeOffset();
 }
 
-const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame() {
+bool QuickTimeDecoder::VideoTrackHandler::dropNextFrame() {
+	if (_reversed || endOfTrack())
+		return false;
+
+	// Frames are decoded on top of the one before them, except for key
+	// frames. So a frame followed by a key frame in the same edit need not
+	// be decoded at all.
+	const uint32 nextFrame = _curFrame + 2;
+	if (_parent->editList.size() == 1 && !endOfCurEdit() && nextFrame < (uint32)getFrameCount() && findKeyFrame(nextFrame) == nextFrame) {
+		_dropMode = kDropDecode;
+		return true;
+	}
+
+	// Other frames still have to be decoded, but need not be dithered or
+	// scaled for output.
+	if (_forcedDitherPalette || _parent->scaleFactorX != 1 || _parent->scaleFactorY != 1 || _decoder->_scaleFactorX != 1 || _decoder->_scaleFactorY != 1) {
+		_dropMode = kDropOutput;
+		return true;
+	}
+
+	return false;
+}
+
+const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame(bool decode) {
 	_curFrame++;
 
 	// Get the next packet
@@ -753,7 +801,13 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 		return 0;
 	}
 
-	const Graphics::Surface *frame = entry->_videoCodec->decodeFrame(*frameData);
+	const Graphics::Surface *frame = 0;
+	if (decode) {
+		frame = entry->_videoCodec->decodeFrame(*frameData);
+		_lastCodec = entry->_videoCodec;
+		_framesBuffered++;
+	}
+
 	delete frameData;
 
 	// Update the palette
@@ -819,6 +873,15 @@ bool QuickTimeDecoder::VideoTrackHandler::endOfCurEdit() const {
 	return getRateAdjustedFrameTime() >= getCurEditTimeOffset() + getCurEditTrackDuration();
 }
 
+void QuickTimeDecoder::VideoTrackHandler::setTrackDirtyRegion(bool track) {
+	for (uint i = 0; i < _parent->sampleDescs.size(); i++) {
+		VideoSampleDesc *desc = (VideoSampleDesc *)_parent->sampleDescs[i];
+
+		if (desc && desc->_videoCodec)
+			desc->_videoCodec->setTrackDirtyRegion(track);
+	}
+}
+
 bool QuickTimeDecoder::VideoTrackHandler::canDither() const {
 	for (uint i = 0; i < _parent->sampleDescs.size(); i++) {
 		VideoSampleDesc *desc = (VideoSampleDesc *)_parent->sampleDescs[i];
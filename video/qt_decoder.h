@@ -138,6 +138,9 @@ private:
 		const Graphics::Surface *decodeNextFrame();
 		const byte *getPalette() const;
 		bool hasDirtyPalette() const { return _curPalette; }
+		void setTrackDirtyRegion(bool track);
+		const Graphics::DirtyRectList *getDirtyRegion() const { return _dirtyRegion; }
+		bool dropNextFrame();
 		bool setReverse(bool reverse);
 		bool isReversed() const { return _reversed; }
 		bool canDither() const;
@@ -158,6 +161,19 @@ private:
 		mutable bool _dirtyPalette;
 		bool _reversed;
 
+		// Changed areas of the last frame, taken from the codec
+		const Graphics::DirtyRectList *_dirtyRegion;
+		Image::Codec *_lastCodec;
+		uint _framesBuffered;
+
+		// How much of the next frame to leave out, see dropNextFrame()
+		enum DropMode {
+			kDropNone,
+			kDropDecode,
+			kDropOutput
+		};
+		DropMode _dropMode;
+
 		// Forced dithering of frames
 		byte *_forcedDitherPalette;
 		byte *_ditherTable;
@@ -168,7 +184,7 @@ private:
 		uint32 getFrameDuration();
 		uint32 findKeyFrame(uint32 frame) const;
 		void enterNewEditList(bool bufferFrames);
-		const Graphics::Surface *bufferNextFrame();
+		const Graphics::Surface *bufferNextFrame(bool decode = true);
 		uint32 getRateAdjustedFrameTime() const;
 		uint32 getCurEditTimeOffset() const;
 		uint32 getCurEditTrackDuration() const;
@@ -378,6 +378,8 @@ bool SmackerDecoder::loadStream(Common::SeekableReadStream *stream) {
 	for (i = 0; i < frameCount; ++i)
 		_frameSizes[i] = _fileStream->readUint32LE();
 
+	videoTrack->setFrameSizes(_frameSizes);
+
 	_frameTypes = new byte[frameCount];
 	for (i = 0; i < frameCount; ++i)
 		_frameTypes[i] = _fileStream->readByte();
@@ -460,6 +462,12 @@ void SmackerDecoder::readNextPacket() {
 	if (_fileStream->pos() - startPos > frameSize)
 		error("Smacker actual frame size exceeds recorded frame size");
 
+	// A dropped frame is not needed to decode the next one, skip its video
+	if (videoTrack->isDroppingFrame()) {
+		_fileStream->seek(startPos + frameSize);
+		return;
+	}
+
 	uint32 frameDataSize = frameSize - (_fileStream->pos() - startPos);
 
 	byte *frameData = (byte *)malloc(frameDataSize + 1);
@@ -520,12 +528,16 @@ VideoDecoder::AudioTrack *SmackerDecoder::getAudioTrack(int index) {
 SmackerDecoder::SmackerVideoTrack::SmackerVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, uint32 flags, uint32 signature) {
 	_surface = new Graphics::Surface();
 	_surface->create(width, height * (flags ? 2 : 1), Graphics::PixelFormat::createFormatCLUT8());
+	_dirtyRegion.setBounds(_surface->w, _surface->h);
+	_trackDirtyRegion = false;
 	_frameCount = frameCount;
 	_frameRate = frameRate;
 	_flags = flags;
 	_signature = signature;
 	_curFrame = -1;
 	_dirtyPalette = false;
+	_frameSizes = 0;
+	_dropFrame = false;
 	_MMapTree = _MClrTree = _FullTree = _TypeTree = 0;
 	memset(_palette, 0, 3 * 256);
 }
@@ -559,6 +571,26 @@ void SmackerDecoder::SmackerVideoTrack::readTrees(Common::BitStreamMemory8LSB &b
 	_TypeTree = new BigHuffmanTree(bs, typeSize);
 }
 
+const Graphics::Surface *SmackerDecoder::SmackerVideoTrack::decodeNextFrame() {
+	if (_dropFrame) {
+		_dropFrame = false;
+		return 0;
+	}
+
+	return _surface;
+}
+
+bool SmackerDecoder::SmackerVideoTrack::dropNextFrame() {
+	// Every frame is decoded on top of the one before it, except for key
+	// frames. So only a frame followed by a key frame can be left out.
+	const uint32 nextFrame = _curFrame + 2;
+	if (!_frameSizes || nextFrame >= _frameCount || !(_frameSizes[nextFrame] & 1))
+		return false;
+
+	_dropFrame = true;
+	return true;
+}
+
 void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB &bs) {
 	_MMapTree->reset();
 	_MClrTree->reset();
@@ -579,6 +611,9 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 	byte hi, lo;
 	uint i;
 
+	_dirtyRegion.clear();
+	Graphics::DirtyBlockCollector dirtyBlocks(_trackDirtyRegion ? &_dirtyRegion : 0);
+
 	while (block < blocks) {
 		type = _TypeTree->getCode(bs);
 		run = getBlockRun((type >> 2) & 0x3f);
@@ -601,6 +636,7 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 					}
 					map >>= 4;
 				}
+				dirtyBlocks.addBlock((block % bw) * 4, (block / bw) * 4 * doubleY, 4, 4 * doubleY);
 				++block;
 			}
 			break;
@@ -678,6 +714,7 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 					default:
 						break;
 				}
+				dirtyBlocks.addBlock((block % bw) * 4, (block / bw) * 4 * doubleY, 4, 4 * doubleY);
 				++block;
 			}
 			break;
@@ -695,6 +732,7 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 					out[0] = out[1] = out[2] = out[3] = col;
 					out += stride;
 				}
+				dirtyBlocks.addBlock((block % bw) * 4, (block / bw) * 4 * doubleY, 4, 4 * doubleY);
 				++block;
 			}
 			break;
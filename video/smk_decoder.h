@@ -25,6 +25,7 @@
 
 #include "common/bitstream.h"
 #include "common/rational.h"
+#include "graphics/dirtyrects.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "video/video_decoder.h"
@@ -80,19 +81,24 @@ protected:
 		~SmackerVideoTrack();
 
 		bool isRewindable() const { return true; }
-		bool rewind() { _curFrame = -1; return true; }
+		bool rewind() { _curFrame = -1; _dropFrame = false; return true; }
 
 		uint16 getWidth() const;
 		uint16 getHeight() const;
 		Graphics::PixelFormat getPixelFormat() const;
 		int getCurFrame() const { return _curFrame; }
 		int getFrameCount() const { return _frameCount; }
-		const Graphics::Surface *decodeNextFrame() { return _surface; }
+		const Graphics::Surface *decodeNextFrame();
 		const byte *getPalette() const { _dirtyPalette = false; return _palette; }
 		bool hasDirtyPalette() const { return _dirtyPalette; }
+		void setTrackDirtyRegion(bool track) { _trackDirtyRegion = track; }
+		const Graphics::DirtyRectList *getDirtyRegion() const { return _trackDirtyRegion ? &_dirtyRegion : 0; }
+		bool dropNextFrame();
 
 		void readTrees(Common::BitStreamMemory8LSB &bs, uint32 mMapSize, uint32 mClrSize, uint32 fullSize, uint32 typeSize);
 		void increaseCurFrame() { _curFrame++; }
+		void setFrameSizes(const uint32 *frameSizes) { _frameSizes = frameSizes; }
+		bool isDroppingFrame() const { return _dropFrame; }
 		void decodeFrame(Common::BitStreamMemory8LSB &bs);
 		void unpackPalette(Common::SeekableReadStream *stream);
 
@@ -100,6 +106,8 @@ protected:
 		Common::Rational getFrameRate() const { return _frameRate; }
 
 		Graphics::Surface *_surface;
+		Graphics::DirtyRectList _dirtyRegion;
+		bool _trackDirtyRegion;
 
 	private:
 		Common::Rational _frameRate;
@@ -111,6 +119,10 @@ protected:
 		int _curFrame;
 		uint32 _frameCount;
 
+		// Bit 0 of a frame's size marks key frames
+		const uint32 *_frameSizes;
+		bool _dropFrame;
+
 		BigHuffmanTree *_MMapTree;
 		BigHuffmanTree *_MClrTree;
 		BigHuffmanTree *_FullTree;
@@ -47,6 +47,11 @@ VideoDecoder::VideoDecoder() {
 	_endTime = 0;
 	_endTimeSet = false;
 	_nextVideoTrack = 0;
+	_lastFrameTrack = 0;
+	_dirtyRegion = 0;
+	_trackDirtyRegion = false;
+	_frameDropThreshold = 0;
+	_droppedFrames = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 
@@ -78,6 +83,9 @@ void VideoDecoder::close() {
 	_endTime = 0;
 	_endTimeSet = false;
 	_nextVideoTrack = 0;
+	_lastFrameTrack = 0;
+	_dirtyRegion = 0;
+	_droppedFrames = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 }
@@ -185,8 +193,17 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 	_canSetDither = false;
 
+	// Drop the frame if playback lags too far behind and the track is able
+	// to. Only forward playback is handled.
+	bool dropped = false;
+	if (_frameDropThreshold && _nextVideoTrack && isPlaying() && !isPaused() && !_nextVideoTrack->isReversed() &&
+			getTime() > _nextVideoTrack->getNextFrameStartTime() + _frameDropThreshold)
+		dropped = _nextVideoTrack->dropNextFrame();
+
 	readNextPacket();
 
+	_dirtyRegion = 0;
+
 	// If we have no next video track at this point, there shouldn't be
 	// any frame available for us to display.
 	if (!_nextVideoTrack)
@@ -194,6 +211,15 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 
 	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
 
+	if (dropped)
+		_droppedFrames++;
+
+	// What a track reports as changed is relative to the frame it returned
+	// before, which is only what is on screen if nothing came in between.
+	if (frame && _lastFrameTrack == _nextVideoTrack)
+		_dirtyRegion = _nextVideoTrack->getDirtyRegion();
+	_lastFrameTrack = frame ? _nextVideoTrack : 0;
+
 	if (_nextVideoTrack->hasDirtyPalette()) {
 		_palette = _nextVideoTrack->getPalette();
 		_dirtyPalette = true;
@@ -210,6 +236,8 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	_lastFrameTrack = 0;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -320,6 +348,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	_lastFrameTrack = 0;
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -354,6 +384,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	_lastFrameTrack = 0;
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -523,6 +555,14 @@ bool VideoDecoder::setDitheringPalette(const byte *palette) {
 	return result;
 }
 
+void VideoDecoder::setTrackDirtyRegion(bool track) {
+	_trackDirtyRegion = track;
+
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
+			((VideoTrack *)*it)->setTrackDirtyRegion(track);
+}
+
 VideoDecoder::Track::Track() {
 	_paused = false;
 }
@@ -738,6 +778,8 @@ void VideoDecoder::addTrack(Track *track, bool isExternal) {
 			}
 		}
 	} else if (track->getTrackType() == Track::kTrackTypeVideo) {
+		((VideoTrack *)track)->setTrackDirtyRegion(_trackDirtyRegion);
+
 		// If this track has a better time, update _nextVideoTrack
 		if (!_nextVideoTrack || ((VideoTrack *)track)->getNextFrameStartTime() < _nextVideoTrack->getNextFrameStartTime())
 			_nextVideoTrack = (VideoTrack *)track;
@@ -41,6 +41,7 @@ class SeekableReadStream;
 }
 
 namespace Graphics {
+class DirtyRectList;
 struct Surface;
 }
 
@@ -355,6 +356,48 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Get the areas in which the frame last returned by decodeNextFrame()
+	 * differs from the frame returned before it.
+	 *
+	 * Returns 0 when this is not known, e.g. for the first frame, after a
+	 * seek or rewind, when tracking was not enabled with
+	 * setTrackDirtyRegion(), or when the video track does not track it. The whole
+	 * frame has to be redrawn then. Only pixel values are compared, so a
+	 * caller converting the frame through the palette still has to redraw
+	 * everything when hasDirtyPalette() is set.
+	 *
+	 * @note The returned list is only valid until the next call to
+	 *       decodeNextFrame().
+	 */
+	const Graphics::DirtyRectList *getDirtyRegion() const { return _dirtyRegion; }
+
+	/**
+	 * Enable or disable tracking of the areas each frame changes, which
+	 * getDirtyRegion() reports. It is off by default, as it costs time
+	 * while decoding that is wasted when nobody asks for the areas.
+	 *
+	 * This applies to the tracks already loaded and to those loaded later.
+	 */
+	void setTrackDirtyRegion(bool track);
+
+	/**
+	 * Let decodeNextFrame() drop frames while playback lags behind by more
+	 * than the given time, so it can catch up again. A dropped frame is
+	 * returned as 0, so the last frame stays on screen.
+	 *
+	 * Only tracks supporting it drop frames, and only in ways that leave the
+	 * frames after them intact, see VideoTrack::dropNextFrame().
+	 *
+	 * @param threshold how late in ms a frame may be, or 0 to never drop frames
+	 */
+	void setFrameDropThreshold(uint32 threshold) { _frameDropThreshold = threshold; }
+
+	/**
+	 * Return the number of frames dropped since the video was loaded.
+	 */
+	uint32 getDroppedFrameCount() const { return _droppedFrames; }
+
 	/**
 	 * Set the default high color format for videos that convert from YUV.
 	 *
@@ -613,6 +656,28 @@ protected:
 		 */
 		virtual bool hasDirtyPalette() const { return false; }
 
+		/**
+		 * Get the areas in which the frame last returned by decodeNextFrame()
+		 * differs from the frame this track returned before it, or 0 if
+		 * that is not known.
+		 */
+		virtual const Graphics::DirtyRectList *getDirtyRegion() const { return 0; }
+
+		/**
+		 * Enable or disable tracking of the areas each frame changes.
+		 */
+		virtual void setTrackDirtyRegion(bool track) {}
+
+		/**
+		 * Drop the next frame, because playback is running late. Its data
+		 * is still read, but need not be decoded when no later frame is
+		 * decoded from it, nor converted for output. The next call to
+		 * decodeNextFrame() then returns 0.
+		 *
+		 * @return true if the next frame will be dropped
+		 */
+		virtual bool dropNextFrame() { return false; }
+
 		/**
 		 * Get the time the given frame should be shown.
 		 *
@@ -939,6 +1004,15 @@ private:
 	Common::Rational _playbackRate;
 	VideoTrack *_nextVideoTrack;
 
+	// Changed areas of the last frame, relative to the one shown before it
+	const VideoTrack *_lastFrameTrack;
+	const Graphics::DirtyRectList *_dirtyRegion;
+	bool _trackDirtyRegion;
+
+	// Frame dropping when playback lags behind
+	uint32 _frameDropThreshold;
+	uint32 _droppedFrames;
+
 	// Palette settings from individual tracks
 	mutable bool _dirtyPalette;
 	const byte *_palette;